@@ -6,10 +6,24 @@
 #include <vector>
 #include <cmath>
 #include <cassert>
+#include "../../common/buffered_text_writer.h"
 
 // Function to save a vector to a file
+// fastWriter formats through BufferedTextWriter instead of std::ofstream with std::endl
 template <typename T>
-void saveVector(const std::string& fileName, const std::vector<T>& vec) {
+void saveVector(const std::string& fileName, const std::vector<T>& vec, bool fastWriter = true) {
+    if (fastWriter) {
+        BufferedTextWriter file(fileName);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file");
+        }
+        for (const auto& val : vec) {
+            file << val << '\n';
+        }
+        file.close();
+        return;
+    }
+
     std::ofstream file(fileName);
     if (!file.is_open()) {
         throw std::runtime_error("Could not open file");
@@ -12,6 +12,8 @@
 #include <atomic>
 #include <numeric>
 #include <fstream>
+#include <string>
+#include "../common/buffered_text_writer.h"
 
 struct Task {
     double a, b, tol;
@@ -169,12 +171,13 @@ double parallel_adaptive(std::function<double(double)> f, double a, double b, do
     return pool.get_result();
 }
 
-int main() {
+// Run every tolerance/thread count combination, writing one CSV row per configuration
+template <typename CsvWriter>
+void run_configurations(CsvWriter& csv_file) {
     auto f = [](double x) { return std::sqrt(x) * std::pow(1 - x, 2); };
     std::vector<int> thread_counts = {1, 2, 4, 8, 16};
     std::vector<double> tolerances = {1e-3, 1e-6};
 
-    std::ofstream csv_file("adaptive_trapezoidal_results.csv");
     csv_file << "tolerance,threads,parallel_result,sequential_result,error,execution_time,mean_evaluations,stddev_evaluations,mean_time,stddev_time\n";
 
     for (double tol : tolerances) {
@@ -196,8 +199,20 @@ int main() {
             csv_file << execution_time << "," << mean_evaluations << "," << stddev_evaluations << "," << mean_time << "," << stddev_time << "\n";
         }
     }
+}
 
-    csv_file.close();
+// Pass --iostream-writer to write the CSV through std::ofstream instead of BufferedTextWriter
+int main(int argc, char* argv[]) {
+    bool fast_writer = !(argc > 1 && std::string(argv[1]) == "--iostream-writer");
+    if (fast_writer) {
+        BufferedTextWriter csv_file("adaptive_trapezoidal_results.csv");
+        run_configurations(csv_file);
+        csv_file.close();
+    } else {
+        std::ofstream csv_file("adaptive_trapezoidal_results.csv");
+        run_configurations(csv_file);
+        csv_file.close();
+    }
     std::cout << "Results saved to adaptive_trapezoidal_results.csv" << std::endl;
 
     return 0;
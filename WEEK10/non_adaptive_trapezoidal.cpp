@@ -6,6 +6,8 @@
 #include <chrono>
 #include <fstream>
 #include <mutex>
+#include <string>
+#include "../common/buffered_text_writer.h"
 
 // Define the function to integrate
 double f(double x) {
@@ -57,12 +59,12 @@ void parallel_trapezoidal(double (*f)(double), double a, double b, int n, int t,
     std_time = std::sqrt(std::accumulate(times.begin(), times.end(), 0.0, [mean_time](double sum, double val) { return sum + (val - mean_time) * (val - mean_time); }) / t);
 }
 
-// Test the implementation with different configurations
-int main() {
+// Test the implementation with different configurations, writing one CSV row per configuration
+template <typename CsvWriter>
+void run_configurations(CsvWriter& csv_file) {
     std::vector<int> n_values = {1000, 10000, 100000};
     std::vector<int> t_values = {1, 2, 4, 8, 16};
 
-    std::ofstream csv_file("parallel_trapezoidal_results.csv");
     csv_file << "n,threads,parallel_result,sequential_result,error,execution_time,mean_eval,std_eval,mean_time,std_time\n";
 
     for (int n : n_values) {
@@ -84,8 +86,20 @@ int main() {
             csv_file << execution_time << "," << mean_eval << "," << std_eval << "," << mean_time << "," << std_time << "\n";
         }
     }
+}
 
-    csv_file.close();
+// Pass --iostream-writer to write the CSV through std::ofstream instead of BufferedTextWriter
+int main(int argc, char* argv[]) {
+    bool fast_writer = !(argc > 1 && std::string(argv[1]) == "--iostream-writer");
+    if (fast_writer) {
+        BufferedTextWriter csv_file("parallel_trapezoidal_results.csv");
+        run_configurations(csv_file);
+        csv_file.close();
+    } else {
+        std::ofstream csv_file("parallel_trapezoidal_results.csv");
+        run_configurations(csv_file);
+        csv_file.close();
+    }
     std::cout << "Results saved to parallel_trapezoidal_results.csv" << std::endl;
 
     return 0;
@@ -1,4 +1,5 @@
 #include "utils.h"
+#include "../common/buffered_text_writer.h"
 
 void calculate_mean_std(const std::vector<double>& data, double& mean, double& std_dev) {
     mean = 0.0;
@@ -14,7 +15,16 @@ void calculate_mean_std(const std::vector<double>& data, double& mean, double& s
     std_dev = std::sqrt(std_dev / data.size());
 }
 
-void log_results(const std::string& filename, const std::string& method, int threads, double time) {
+void log_results(const std::string& filename, const std::string& method, int threads, double time, bool fast_writer) {
+    if (fast_writer) {
+        BufferedTextWriter file(filename, std::ios::app);
+        if (file.is_open()) {
+            file << method << ',' << threads << ',' << time << '\n';
+        } else {
+            std::cerr << "Error: Could not open file " << filename << "\n";
+        }
+        return;
+    }
     std::ofstream file(filename, std::ios::app);
     if (file.is_open()) {
         file << method << "," << threads << "," << time << "\n";
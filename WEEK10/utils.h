@@ -32,6 +32,7 @@ private:
 void calculate_mean_std(const std::vector<double>& data, double& mean, double& std_dev);
 
 // Logging utility for performance data
-void log_results(const std::string& filename, const std::string& method, int threads, double time);
+// fast_writer formats through BufferedTextWriter instead of std::ofstream
+void log_results(const std::string& filename, const std::string& method, int threads, double time, bool fast_writer = true);
 
 #endif // UTILS_H
@@ -0,0 +1,114 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <functional>
+#include <filesystem>
+#include "temperature_io.h"
+
+/**
+ * Times a reader over several repetitions.
+ *
+ * @param reader The reader to time.
+ * @param repeats The number of timed repetitions.
+ * @param mean_time Set to the mean wall-clock time in seconds.
+ * @param std_time Set to the standard deviation of the wall-clock time in seconds.
+ * @return The values read by the last repetition, or nullopt if the reader failed.
+ */
+std::optional<std::vector<float>> time_reader(const std::function<std::optional<std::vector<float>>()>& reader,
+                                              int repeats, double& mean_time, double& std_time)
+{
+    std::vector<double> times;
+    std::optional<std::vector<float>> T;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        T = reader();
+        auto end_time = std::chrono::high_resolution_clock::now();
+        if (!T)
+        {
+            return std::nullopt;
+        }
+        times.push_back(std::chrono::duration<double>(end_time - start_time).count());
+    }
+
+    mean_time = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    std_time = std::sqrt(std::accumulate(times.begin(), times.end(), 0.0, [mean_time](double sum, double val) { return sum + (val - mean_time) * (val - mean_time); }) / times.size());
+    return T;
+}
+
+/**
+ * @brief Compares the getline/stof reader against the memory-mapped and parallel readers on a CSV
+ * file produced by generate_csv, at 1/2/4/8/16 threads, and writes the timings to a CSV file.
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <csv file from generate_csv> [repeats]" << std::endl;
+        return 1;
+    }
+
+    std::string filename = argv[1];
+    int repeats = argc == 3 ? std::stoi(argv[2]) : 3;
+    if (repeats <= 0)
+    {
+        std::cerr << "Error: The number of repeats must be a positive integer." << std::endl;
+        return 1;
+    }
+    if (!std::filesystem::exists(filename))
+    {
+        std::cerr << "Error: File does not exist: " << filename << std::endl;
+        return 1;
+    }
+    double file_mb = std::filesystem::file_size(filename) / (1024.0 * 1024.0);
+
+    std::ofstream csv_file("reader_benchmark_results.csv");
+    csv_file << "reader,threads,values,file_mb,mean_time,std_time,mb_per_s,speedup\n";
+
+    double mean_time, std_time;
+    auto reference = time_reader([&] { return read_temperature_profile(filename); }, repeats, mean_time, std_time);
+    if (!reference)
+    {
+        std::cerr << "The reference reader failed. Exiting program." << std::endl;
+        return 1;
+    }
+    const double legacy_time = mean_time;
+    csv_file << "legacy," << 1 << "," << reference->size() << "," << file_mb << "," << mean_time << "," << std_time << ","
+             << file_mb / mean_time << "," << 1.0 << "\n";
+    std::cout << "legacy:   " << mean_time << " s (" << file_mb / mean_time << " MB/s)" << std::endl;
+
+    auto mapped = time_reader([&] { return read_temperature_profile_mapped(filename); }, repeats, mean_time, std_time);
+    if (!mapped || *mapped != *reference)
+    {
+        std::cerr << "The memory-mapped reader does not match the reference reader." << std::endl;
+        return 1;
+    }
+    csv_file << "mapped," << 1 << "," << mapped->size() << "," << file_mb << "," << mean_time << "," << std_time << ","
+             << file_mb / mean_time << "," << legacy_time / mean_time << "\n";
+    std::cout << "mapped:   " << mean_time << " s (" << file_mb / mean_time << " MB/s)" << std::endl;
+
+    std::vector<int> t_values = {1, 2, 4, 8, 16};
+    for (int t : t_values)
+    {
+        auto parallel = time_reader([&] { return read_temperature_profile_parallel(filename, t); }, repeats, mean_time, std_time);
+        if (!parallel || *parallel != *reference)
+        {
+            std::cerr << "The parallel reader does not match the reference reader at " << t << " threads." << std::endl;
+            return 1;
+        }
+        csv_file << "parallel," << t << "," << parallel->size() << "," << file_mb << "," << mean_time << "," << std_time << ","
+                 << file_mb / mean_time << "," << legacy_time / mean_time << "\n";
+        std::cout << "parallel (" << t << " threads): " << mean_time << " s (" << file_mb / mean_time << " MB/s)" << std::endl;
+    }
+
+    csv_file.close();
+    std::cout << "Results saved to reader_benchmark_results.csv" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <functional>
+#include <filesystem>
+#include "temperature_io.h"
+#include "temperature_binary.h"
+
+/**
+ * Times a writer over several repetitions.
+ *
+ * @param writer The writer to time.
+ * @param repeats The number of timed repetitions.
+ * @param mean_time Set to the mean wall-clock time in seconds.
+ * @param std_time Set to the standard deviation of the wall-clock time in seconds.
+ */
+void time_writer(const std::function<void()>& writer, int repeats, double& mean_time, double& std_time)
+{
+    std::vector<double> times;
+    for (int r = 0; r < repeats; ++r)
+    {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        writer();
+        auto end_time = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double>(end_time - start_time).count());
+    }
+
+    mean_time = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    std_time = std::sqrt(std::accumulate(times.begin(), times.end(), 0.0, [mean_time](double sum, double val) { return sum + (val - mean_time) * (val - mean_time); }) / times.size());
+}
+
+/**
+ * @brief Compares the write time, throughput and file size of the iostream and to_chars text
+ * writers and the binary writer on a synthetic profile, and writes the results to a CSV file.
+ *
+ * @return int The exit status of the program.
+ */
+int main(int argc, char* argv[])
+{
+    if (argc > 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " [num_values] [repeats]" << std::endl;
+        return 1;
+    }
+
+    long long num_values = argc >= 2 ? std::stoll(argv[1]) : 10000000;
+    int repeats = argc == 3 ? std::stoi(argv[2]) : 3;
+    if (num_values <= 0 || repeats <= 0)
+    {
+        std::cerr << "Error: The number of values and repeats must be positive integers." << std::endl;
+        return 1;
+    }
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> T(static_cast<std::size_t>(num_values));
+    for (auto& temp : T)
+    {
+        temp = distribution(generator);
+    }
+
+    std::ofstream csv_file("writer_benchmark_results.csv");
+    csv_file << "format,values,mean_time,std_time,file_bytes,values_per_s\n";
+
+    double mean_time, std_time;
+    const std::string text_filename = "benchmark_normalized_temperature.txt";
+    time_writer([&] { write_normalized_temperature_profile(text_filename, T, false); }, repeats, mean_time, std_time);
+    auto text_bytes = std::filesystem::file_size(text_filename);
+    csv_file << "text_iostream," << T.size() << "," << mean_time << "," << std_time << "," << text_bytes << "," << T.size() / mean_time << "\n";
+    std::cout << "text (iostream): " << mean_time << " s, " << text_bytes << " bytes, " << T.size() / mean_time << " values/s" << std::endl;
+
+    time_writer([&] { write_normalized_temperature_profile(text_filename, T, true); }, repeats, mean_time, std_time);
+    text_bytes = std::filesystem::file_size(text_filename);
+    csv_file << "text_to_chars," << T.size() << "," << mean_time << "," << std_time << "," << text_bytes << "," << T.size() / mean_time << "\n";
+    std::cout << "text (to_chars): " << mean_time << " s, " << text_bytes << " bytes, " << T.size() / mean_time << " values/s" << std::endl;
+
+    // Shortest round-trip output must parse back to exactly the values written
+    auto T_back = read_temperature_profile_mapped(text_filename);
+    if (!T_back || *T_back != T)
+    {
+        std::cerr << "The to_chars text file does not read back to the values written." << std::endl;
+        return 1;
+    }
+
+    const std::string binary_filename = "benchmark_normalized_temperature.bin";
+    time_writer([&] { write_normalized_temperature_binary(binary_filename, T, 0.0f, 1.0f); }, repeats, mean_time, std_time);
+    auto binary_bytes = std::filesystem::file_size(binary_filename);
+    csv_file << "binary," << T.size() << "," << mean_time << "," << std_time << "," << binary_bytes << "," << T.size() / mean_time << "\n";
+    std::cout << "binary:          " << mean_time << " s, " << binary_bytes << " bytes, " << T.size() / mean_time << " values/s" << std::endl;
+
+    MappedTemperatureProfile profile;
+    if (!profile.open(binary_filename) || profile.size() != T.size() ||
+        !std::equal(T.begin(), T.end(), profile.data()))
+    {
+        std::cerr << "The binary file does not read back to the values written." << std::endl;
+        return 1;
+    }
+
+    csv_file.close();
+    std::filesystem::remove(text_filename);
+    std::filesystem::remove(binary_filename);
+    std::cout << "Results saved to writer_benchmark_results.csv" << std::endl;
+
+    return 0;
+}
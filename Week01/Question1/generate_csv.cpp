@@ -1,56 +1,276 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
-#include <cstdlib>
-#include <ctime>
 #include <string> // Include this header for std::stoi
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <thread>
+#include <future>
+#include <algorithm>
+#include <utility>
+#include "temperature_binary.h"
+
+// Values generated per chunk. Every chunk has its own random stream, so the output depends on
+// the seed only, not on the number of threads.
+constexpr std::size_t values_per_chunk = 1 << 20;
+
+// Longest shortest-round-trip float plus the separator ("-1.17549435e-38,")
+constexpr std::size_t max_value_chars = 16;
+
+/**
+ * xoshiro256+ generator (Blackman and Vigna), seeded through SplitMix64.
+ * Its upper bits, the only ones used here, are of high quality.
+ */
+class Xoshiro256Plus
+{
+public:
+    Xoshiro256Plus(std::uint64_t seed, std::uint64_t stream)
+    {
+        std::uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull);
+        for (auto& word : s_)
+        {
+            word = split_mix64(x);
+        }
+    }
+
+    std::uint64_t next()
+    {
+        const std::uint64_t result = s_[0] + s_[3];
+        const std::uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = (s_[3] << 45) | (s_[3] >> 19);
+        return result;
+    }
+
+    // Uniform float in [0, 1) from the upper 24 bits
+    float next_float()
+    {
+        return static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+    }
+
+private:
+    static std::uint64_t split_mix64(std::uint64_t& x)
+    {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t s_[4];
+};
 
 /**
- * Generates a CSV file with random temperature data.
+ * Generates one chunk of random temperatures between 0 and 100 and formats it into a buffer.
+ *
+ * @param seed The seed of the whole file.
+ * @param chunk The index of the chunk, which selects its random stream.
+ * @param count The number of values in the chunk.
+ * @param last_chunk Whether this is the last chunk of the file, whose last value has no separator.
+ * @param binary Format as little-endian float32 instead of comma-separated text.
+ * @param buffer Set to the formatted bytes.
+ * @param range Set to the smallest and largest value of the chunk, in binary mode.
+ */
+void generate_chunk(std::uint64_t seed, std::uint64_t chunk, std::size_t count, bool last_chunk, bool binary,
+                    std::vector<char>& buffer, std::pair<float, float>& range)
+{
+    Xoshiro256Plus rng(seed, chunk);
+    if (binary)
+    {
+        buffer.resize(count * sizeof(float));
+        unsigned char* out = reinterpret_cast<unsigned char*>(buffer.data());
+        float lo = 100.0f, hi = 0.0f;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const float value = rng.next_float() * 100.0f;
+            lo = std::min(lo, value);
+            hi = std::max(hi, value);
+            store_little_endian<float>(out + i * sizeof(float), value);
+        }
+        range = {lo, hi};
+        return;
+    }
+
+    buffer.resize(count * max_value_chars);
+    char* pos = buffer.data();
+    char* const end = buffer.data() + buffer.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pos = std::to_chars(pos, end, rng.next_float() * 100.0f).ptr;
+        *pos++ = ',';
+    }
+    if (last_chunk && count > 0)
+    {
+        --pos;
+    }
+    buffer.resize(static_cast<std::size_t>(pos - buffer.data()));
+}
+
+/**
+ * Generates a file with random temperature data between 0 and 100.
+ *
+ * The values are generated in chunks, each from its own xoshiro256+ stream derived from the
+ * seed, so a given seed always produces the same file. Worker threads format a round of chunks
+ * into their own buffers while the previous round is written to the file in order.
  *
  * @param filename The name of the file to write the temperature data to.
  * @param num_steps The number of time steps to generate.
+ * @param seed The seed of the random streams.
+ * @param num_threads The number of threads formatting chunks; 0 uses all hardware threads.
+ * @param binary Write the binary format of temperature_binary.h instead of CSV text.
+ * @return true on success, false if the file cannot be opened or written.
  */
-void generate_temperature_csv(const std::string& filename, int num_steps)
+bool generate_temperature_csv(const std::string& filename, long long num_steps, std::uint64_t seed = 42,
+                              int num_threads = 0, bool binary = false)
 {
-    std::ofstream outfile(filename);
+    std::ofstream outfile(filename, std::ios::out | std::ios::binary);
     if (!outfile.is_open())
     {
         std::cerr << "Error opening file for writing: " << filename << std::endl;
-        return;
+        return false;
+    }
+
+    if (binary)
+    {
+        // The range of the values is filled in once they have all been generated
+        unsigned char header[temperature_binary_header_size];
+        fill_temperature_binary_header(header, static_cast<std::uint64_t>(num_steps), 0.0f, 0.0f);
+        outfile.write(reinterpret_cast<const char*>(header), sizeof(header));
+    }
+
+    if (num_threads <= 0)
+    {
+        num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
     }
 
-    std::srand(std::time(nullptr));
-    for (int i = 0; i < num_steps; ++i)
+    const std::uint64_t total = num_steps > 0 ? static_cast<std::uint64_t>(num_steps) : 0;
+    const std::uint64_t num_chunks = (total + values_per_chunk - 1) / values_per_chunk;
+
+    // Formats chunks [first, first + buffers.size()) into buffers, one thread per chunk
+    auto format_round = [&](std::uint64_t first, std::vector<std::vector<char>>& buffers,
+                            std::vector<std::pair<float, float>>& ranges) {
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < buffers.size(); ++t)
+        {
+            const std::uint64_t chunk = first + t;
+            if (chunk >= num_chunks)
+            {
+                buffers[t].clear();
+                ranges[t] = {100.0f, 0.0f};
+                continue;
+            }
+            const std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(values_per_chunk, total - chunk * values_per_chunk));
+            workers.emplace_back(generate_chunk, seed, chunk, count, chunk + 1 == num_chunks, binary, std::ref(buffers[t]),
+                                 std::ref(ranges[t]));
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    };
+
+    // Two rounds of buffers: one being written while the other is formatted
+    std::vector<std::vector<char>> current(num_threads), next(num_threads);
+    std::vector<std::pair<float, float>> current_ranges(num_threads), next_ranges(num_threads);
+    float lo = 100.0f, hi = 0.0f;
+    if (num_chunks > 0)
+    {
+        format_round(0, current, current_ranges);
+    }
+    for (std::uint64_t first = 0; first < num_chunks; first += num_threads)
     {
-        float temp = static_cast<float>(std::rand()) / RAND_MAX * 100.0f; // Random temperature between 0 and 100
-        outfile << temp;
-        if (i < num_steps - 1)
+        std::future<void> formatting;
+        if (first + num_threads < num_chunks)
+        {
+            formatting = std::async(std::launch::async, format_round, first + num_threads, std::ref(next),
+                                    std::ref(next_ranges));
+        }
+        for (const auto& buffer : current)
         {
-            outfile << ",";
+            outfile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
         }
+        for (const auto& range : current_ranges)
+        {
+            lo = std::min(lo, range.first);
+            hi = std::max(hi, range.second);
+        }
+        if (formatting.valid())
+        {
+            formatting.get();
+        }
+        current.swap(next);
+        current_ranges.swap(next_ranges);
     }
 
+    if (binary && total > 0)
+    {
+        unsigned char range[2 * sizeof(float)];
+        store_little_endian<float>(range, lo);
+        store_little_endian<float>(range + sizeof(float), hi);
+        outfile.seekp(16);
+        outfile.write(reinterpret_cast<const char*>(range), sizeof(range));
+    }
+
+    outfile.close();
     if (outfile.fail())
     {
         std::cerr << "Error writing to file: " << filename << std::endl;
+        return false;
     }
+    return true;
 }
 
 int main(int argc, char* argv[])
 {
-    if (argc != 3)
+    if (argc < 3)
     {
-        std::cerr << "Usage: " << argv[0] << " <filename> <num_steps>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <filename> <num_steps> [--seed S] [--threads N] [--binary]" << std::endl;
         return 1;
     }
 
     std::string filename = argv[1];
-    int num_steps = std::stoi(argv[2]);
+    long long num_steps = std::stoll(argv[2]);
+    std::uint64_t seed = 42;
+    int num_threads = 0;
+    bool binary = false;
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if (option == "--seed" && i + 1 < argc)
+        {
+            seed = std::stoull(argv[++i]);
+        }
+        else if (option == "--threads" && i + 1 < argc)
+        {
+            num_threads = std::stoi(argv[++i]);
+        }
+        else if (option == "--binary")
+        {
+            binary = true;
+        }
+        else
+        {
+            std::cerr << "Unknown or incomplete option: " << option << std::endl;
+            return 1;
+        }
+    }
+    if (num_steps < 0 || num_threads < 0)
+    {
+        std::cerr << "Error: The number of steps and threads must be non-negative integers." << std::endl;
+        return 1;
+    }
 
-    generate_temperature_csv(filename, num_steps);
+    if (!generate_temperature_csv(filename, num_steps, seed, num_threads, binary))
+    {
+        return 1;
+    }
 
-    std::cout << "Temperature data written to '" << filename << "'." << std::endl;
+    std::cout << "Temperature data written to '" << filename << "' (seed " << seed << ")." << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
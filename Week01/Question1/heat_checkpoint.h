@@ -0,0 +1,228 @@
+#ifndef HEAT_CHECKPOINT_H
+#define HEAT_CHECKPOINT_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "temperature_binary.h"
+
+// Checkpoint file layout, all fields little-endian:
+//
+//   offset  size  field
+//        0     4  magic "HCKP"
+//        4     2  format version (1)
+//        6     2  dtype (1 = float32)
+//        8     8  grid size N
+//       16     8  number of completed time steps
+//       24     4  a
+//       28     4  b
+//       32     4  dt
+//       36     4  time scheme (0 = explicit, 1 = backward Euler, 2 = Crank-Nicolson)
+//       40   4*N  grid values
+constexpr char heatCheckpointMagic[4] = {'H', 'C', 'K', 'P'};
+constexpr std::uint16_t heatCheckpointVersion = 1;
+constexpr std::size_t heatCheckpointHeaderSize = 40;
+
+// Run parameters stored with a checkpoint; a restart must use the same N, a, b, dt and scheme.
+// Checkpoints written before the scheme was recorded have 0 there and read as explicit.
+struct CheckpointHeader {
+    std::uint64_t N = 0;
+    std::uint64_t step = 0;
+    float a = 0.0f;
+    float b = 0.0f;
+    float dt = 0.0f;
+    std::uint32_t scheme = 0;
+};
+
+// Function to write a checkpoint. The data goes to a temporary file that then replaces the
+// checkpoint, so a crash while writing leaves the previous checkpoint intact.
+inline bool writeCheckpoint(const std::string& checkpointFile, const CheckpointHeader& header, const std::vector<float>& grid) {
+    const std::string tempFile = checkpointFile + ".tmp";
+    {
+        std::ofstream outFile(tempFile, std::ios::out | std::ios::binary);
+        if (!outFile) {
+            std::cerr << "Error opening checkpoint file: " << tempFile << "\n";
+            return false;
+        }
+
+        unsigned char bytes[heatCheckpointHeaderSize] = {};
+        std::memcpy(bytes, heatCheckpointMagic, 4);
+        store_little_endian<std::uint16_t>(bytes + 4, heatCheckpointVersion);
+        store_little_endian<std::uint16_t>(bytes + 6, temperature_dtype_float32);
+        store_little_endian<std::uint64_t>(bytes + 8, grid.size());
+        store_little_endian<std::uint64_t>(bytes + 16, header.step);
+        store_little_endian<float>(bytes + 24, header.a);
+        store_little_endian<float>(bytes + 28, header.b);
+        store_little_endian<float>(bytes + 32, header.dt);
+        store_little_endian<std::uint32_t>(bytes + 36, header.scheme);
+        outFile.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+        write_float32_little_endian(outFile, grid.data(), grid.size());
+
+        outFile.close();
+        if (outFile.fail()) {
+            std::cerr << "Error writing checkpoint file: " << tempFile << "\n";
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempFile, checkpointFile, error);
+    if (error) {
+        std::cerr << "Error replacing checkpoint file " << checkpointFile << ": " << error.message() << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Function to read a checkpoint written by writeCheckpoint
+inline bool readCheckpoint(const std::string& checkpointFile, CheckpointHeader& header, std::vector<float>& grid) {
+    std::ifstream inFile(checkpointFile, std::ios::in | std::ios::binary);
+    if (!inFile) {
+        std::cerr << "Error opening checkpoint file: " << checkpointFile << "\n";
+        return false;
+    }
+
+    unsigned char bytes[heatCheckpointHeaderSize];
+    if (!inFile.read(reinterpret_cast<char*>(bytes), sizeof(bytes)) || std::memcmp(bytes, heatCheckpointMagic, 4) != 0 ||
+        load_little_endian<std::uint16_t>(bytes + 4) != heatCheckpointVersion ||
+        load_little_endian<std::uint16_t>(bytes + 6) != temperature_dtype_float32) {
+        std::cerr << "Error: " << checkpointFile << " is not a heat_distribution checkpoint.\n";
+        return false;
+    }
+    header.N = load_little_endian<std::uint64_t>(bytes + 8);
+    header.step = load_little_endian<std::uint64_t>(bytes + 16);
+    header.a = load_little_endian<float>(bytes + 24);
+    header.b = load_little_endian<float>(bytes + 28);
+    header.dt = load_little_endian<float>(bytes + 32);
+    header.scheme = load_little_endian<std::uint32_t>(bytes + 36);
+
+    // Check the count against the file before allocating, so a corrupt count cannot ask for
+    // an arbitrary amount of memory
+    std::error_code error;
+    const std::uintmax_t fileSize = std::filesystem::file_size(checkpointFile, error);
+    if (error || header.N > (fileSize - heatCheckpointHeaderSize) / sizeof(float)) {
+        std::cerr << "Error: Checkpoint file " << checkpointFile << " is truncated.\n";
+        return false;
+    }
+    grid.resize(header.N);
+    if (!inFile.read(reinterpret_cast<char*>(grid.data()), static_cast<std::streamsize>(header.N * sizeof(float)))) {
+        std::cerr << "Error: Checkpoint file " << checkpointFile << " is truncated.\n";
+        return false;
+    }
+    if (!host_is_little_endian()) {
+        for (auto& value : grid) {
+            value = load_little_endian<float>(reinterpret_cast<const unsigned char*>(&value));
+        }
+    }
+    return true;
+}
+
+// Writes checkpoints on a background thread so that the time-stepping loop never waits for the disk.
+//
+// submit() copies the grid into a pending buffer and returns; the I/O thread swaps that buffer
+// with the one it writes from, so the copy is the only cost to the caller. If a snapshot is
+// still pending when the next one is submitted, the newer one replaces it.
+class CheckpointWriter {
+public:
+    // keepSnapshots also keeps a copy of every checkpoint written, named <checkpointFile>.<step>
+    CheckpointWriter(const std::string& checkpointFile, float a, float b, float dt, std::uint32_t scheme, bool keepSnapshots = false)
+        : checkpointFile_(checkpointFile), keepSnapshots_(keepSnapshots) {
+        header_.a = a;
+        header_.b = b;
+        header_.dt = dt;
+        header_.scheme = scheme;
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~CheckpointWriter() {
+        finish();
+    }
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    void submit(const std::vector<float>& grid, std::uint64_t step) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (hasPending_) {
+            ++skipped_;
+        }
+        pending_.assign(grid.begin(), grid.end());
+        pendingStep_ = step;
+        hasPending_ = true;
+        ready_.notify_one();
+    }
+
+    // Writes any pending snapshot and stops the I/O thread. Returns false if any write failed.
+    bool finish() {
+        if (thread_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            ready_.notify_one();
+            thread_.join();
+            if (skipped_ > 0) {
+                std::cerr << "Warning: " << skipped_ << " checkpoints were superseded before they could be written.\n";
+            }
+        }
+        return !failed_;
+    }
+
+private:
+    void run() {
+        std::vector<float> writing;
+        for (;;) {
+            CheckpointHeader header = header_;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] { return hasPending_ || stop_; });
+                if (!hasPending_) {
+                    return;
+                }
+                writing.swap(pending_);
+                header.step = pendingStep_;
+                hasPending_ = false;
+            }
+
+            header.N = writing.size();
+            if (!writeCheckpoint(checkpointFile_, header, writing)) {
+                failed_ = true;
+                continue;
+            }
+            if (keepSnapshots_) {
+                std::error_code error;
+                std::filesystem::copy_file(checkpointFile_, checkpointFile_ + "." + std::to_string(header.step),
+                                           std::filesystem::copy_options::overwrite_existing, error);
+                if (error) {
+                    std::cerr << "Error keeping snapshot of step " << header.step << ": " << error.message() << "\n";
+                    failed_ = true;
+                }
+            }
+        }
+    }
+
+    std::string checkpointFile_;
+    bool keepSnapshots_;
+    CheckpointHeader header_;
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::vector<float> pending_;
+    std::uint64_t pendingStep_ = 0;
+    bool hasPending_ = false;
+    bool stop_ = false;
+    int skipped_ = 0;
+    std::atomic<bool> failed_{false};
+    std::thread thread_;
+};
+
+#endif // HEAT_CHECKPOINT_H
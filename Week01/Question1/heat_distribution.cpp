@@ -4,11 +4,29 @@
 #include <string>
 #include <sstream>
 #include <cmath>
+#include <thread>
+#include <algorithm>
+#include <memory>
+#include "heat_solver.h"
+#include "heat_checkpoint.h"
+#include "../../common/buffered_text_writer.h"
+
+// Optional settings given after the positional arguments
+struct SimulationOptions {
+    int threads = 1; // threads stepping the rod; 0 uses all hardware threads
+    TimeScheme scheme = TimeScheme::Explicit;
+    int checkpointEvery = 0;    // time steps between checkpoints; 0 disables them
+    std::string checkpointFile; // defaults to <output file>.ckpt
+    bool keepSnapshots = false; // keep every checkpoint as <checkpoint file>.<step>
+    bool restart = false;       // resume from the checkpoint file instead of the input file
+};
 
 // Function to parse command-line arguments
-bool parseArguments(int argc, char* argv[], int& N, float& a, float& b, float& dt, int& timeSteps, std::string& inputFile, std::string& outputFile) {
-    if (argc != 8) {
-        std::cerr << "Usage: " << argv[0] << " <grid size N> <a> <b> <time step dt> <number of time steps> <input file> <output file>\n";
+bool parseArguments(int argc, char* argv[], int& N, float& a, float& b, float& dt, int& timeSteps, std::string& inputFile, std::string& outputFile,
+                    SimulationOptions& options) {
+    if (argc < 8) {
+        std::cerr << "Usage: " << argv[0] << " <grid size N> <a> <b> <time step dt> <number of time steps> <input file> <output file> [--threads N] [--scheme explicit|backward-euler|crank-nicolson]"
+                  << " [--checkpoint-every STEPS] [--checkpoint-file FILE] [--keep-snapshots] [--restart]\n";
         return false;
     }
     std::stringstream ss;
@@ -65,10 +83,68 @@ bool parseArguments(int argc, char* argv[], int& N, float& a, float& b, float& d
         std::cerr << "Error: Output file name cannot be empty.\n";
         return false;
     }
+
+    // Parse options
+    for (int i = 8; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--threads" && i + 1 < argc) {
+            ss.clear();
+            ss.str(argv[++i]);
+            if (!(ss >> options.threads) || options.threads < 0) {
+                std::cerr << "Error: Invalid number of threads. It must be a non-negative integer.\n";
+                return false;
+            }
+        } else if (option == "--scheme" && i + 1 < argc) {
+            std::string scheme = argv[++i];
+            if (scheme == "explicit") {
+                options.scheme = TimeScheme::Explicit;
+            } else if (scheme == "backward-euler") {
+                options.scheme = TimeScheme::BackwardEuler;
+            } else if (scheme == "crank-nicolson") {
+                options.scheme = TimeScheme::CrankNicolson;
+            } else {
+                std::cerr << "Error: Invalid scheme. It must be explicit, backward-euler or crank-nicolson.\n";
+                return false;
+            }
+        } else if (option == "--checkpoint-every" && i + 1 < argc) {
+            ss.clear();
+            ss.str(argv[++i]);
+            if (!(ss >> options.checkpointEvery) || options.checkpointEvery <= 0) {
+                std::cerr << "Error: Invalid checkpoint interval. It must be a positive integer.\n";
+                return false;
+            }
+        } else if (option == "--checkpoint-file" && i + 1 < argc) {
+            options.checkpointFile = argv[++i];
+        } else if (option == "--keep-snapshots") {
+            options.keepSnapshots = true;
+        } else if (option == "--restart") {
+            options.restart = true;
+        } else {
+            std::cerr << "Error: Unknown or incomplete option: " << option << "\n";
+            return false;
+        }
+    }
+    
+    if (options.checkpointFile.empty()) {
+        options.checkpointFile = outputFile + ".ckpt";
+    }
     
     return true;
 }
 
+// The --scheme name of a time scheme, or of the code a checkpoint stores for it
+const char* schemeName(std::uint32_t scheme) {
+    switch (scheme) {
+    case static_cast<std::uint32_t>(TimeScheme::Explicit):
+        return "explicit";
+    case static_cast<std::uint32_t>(TimeScheme::BackwardEuler):
+        return "backward-euler";
+    case static_cast<std::uint32_t>(TimeScheme::CrankNicolson):
+        return "crank-nicolson";
+    }
+    return "unknown";
+}
+
 // Function to read the initial temperature distribution from a file
 std::vector<float> readInitialTemperature(const std::string& inputFile, int N) {
     std::vector<float> grid(N);
@@ -85,36 +161,79 @@ std::vector<float> readInitialTemperature(const std::string& inputFile, int N) {
 }
 
 // Function to perform the time-stepping for heat distribution
-void timeStepHeatDistribution(std::vector<float>& grid, float dt, int timeSteps, float dx) {
-    std::vector<float> newGrid = grid;
+// Steps firstStep..timeSteps; with a checkpoint writer, the grid is handed to it every
+// options.checkpointEvery steps
+void timeStepHeatDistribution(std::vector<float>& grid, float dt, int timeSteps, float dx, const SimulationOptions& options,
+                              int firstStep = 0, CheckpointWriter* checkpoints = nullptr) {
     float alpha = dt / (dx * dx); // Thermal diffusivity coefficient
 
-    // Stability check
-    if (alpha > 0.5) {
-        std::cerr << "Error: The time step dt is too large for stability. Reduce dt or increase dx.\n";
+    // Stability check; the implicit schemes are unconditionally stable and allow much larger dt
+    if (options.scheme == TimeScheme::Explicit && alpha > 0.5) {
+        std::cerr << "Error: The time step dt is too large for stability. Reduce dt, increase dx or use an implicit --scheme.\n";
         return;
     }
 
-    for (int t = 0; t < timeSteps; ++t) {
-        for (size_t i = 1; i < grid.size() - 1; ++i) {
-            newGrid[i] = grid[i] + alpha * (grid[i - 1] - 2 * grid[i] + grid[i + 1]);
-            if (std::isnan(newGrid[i])) {
-                std::cerr << "NaN detected at time step " << t << ", index " << i << "\n";
-                return;
-            }
+    // threads > 1 splits the rod into slabs stepped concurrently
+    int threads = options.threads;
+    if (threads == 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    std::unique_ptr<ImplicitHeatSolver> implicitSolver;
+    if (options.scheme != TimeScheme::Explicit) {
+        implicitSolver = std::make_unique<ImplicitHeatSolver>(grid.size(), alpha, options.scheme);
+    }
+
+    // Double-buffered, vectorized and cache-blocked; NaN/Inf is checked periodically
+    auto advance = [&](int steps) {
+        if (implicitSolver) {
+            return implicitSolver->advance(grid, steps);
+        }
+        if (threads > 1) {
+            return advanceExplicitParallel(grid, alpha, steps, threads);
+        }
+        return advanceExplicit(grid, alpha, steps);
+    };
+
+    const int every = checkpoints ? options.checkpointEvery : 0;
+    for (int step = firstStep; step < timeSteps;) {
+        int steps = every > 0 ? std::min(every - step % every, timeSteps - step) : timeSteps - step;
+        if (!advance(steps)) {
+            return;
+        }
+        step += steps;
+        if (every > 0 && step % every == 0) {
+            checkpoints->submit(grid, step);
         }
-        grid = newGrid;
     }
 }
 
 // Function to write the grid to a file
-void writeGridToFile(const std::vector<float>& grid, float a, float b, const std::string& outputFile) {
+// fastWriter formats through BufferedTextWriter instead of std::ofstream
+void writeGridToFile(const std::vector<float>& grid, float a, float b, const std::string& outputFile, bool fastWriter = true) {
+    float dx = (b - a) / (grid.size() - 1);
+    if (fastWriter) {
+        BufferedTextWriter outFile(outputFile);
+        if (!outFile.is_open()) {
+            std::cerr << "Error opening output file: " << outputFile << "\n";
+            return;
+        }
+        for (size_t i = 0; i < grid.size(); ++i) {
+            float x = a + i * dx;
+            outFile << x << ' ' << grid[i] << '\n';
+        }
+        outFile.close();
+        if (outFile.fail()) {
+            std::cerr << "Error writing to output file: " << outputFile << "\n";
+        }
+        return;
+    }
+
     std::ofstream outFile(outputFile);
     if (!outFile) {
         std::cerr << "Error opening output file: " << outputFile << "\n";
         return;
     }
-    float dx = (b - a) / (grid.size() - 1);
     for (size_t i = 0; i < grid.size(); ++i) {
         float x = a + i * dx;
         outFile << x << " " << grid[i] << "\n";
@@ -130,16 +249,47 @@ int main(int argc, char* argv[]) {
     float a, b, dt;
     int timeSteps;
     std::string inputFile, outputFile;
+    SimulationOptions options;
 
-    if (!parseArguments(argc, argv, N, a, b, dt, timeSteps, inputFile, outputFile)) {
+    if (!parseArguments(argc, argv, N, a, b, dt, timeSteps, inputFile, outputFile, options)) {
         return 1;
     }
 
-    std::vector<float> grid = readInitialTemperature(inputFile, N);
+    std::vector<float> grid;
+    int firstStep = 0;
+    if (options.restart) {
+        CheckpointHeader header;
+        if (!readCheckpoint(options.checkpointFile, header, grid)) {
+            return 1;
+        }
+        if (header.N != static_cast<std::uint64_t>(N) || header.a != a || header.b != b || header.dt != dt) {
+            std::cerr << "Error: Checkpoint " << options.checkpointFile << " was written for N = " << header.N << ", a = " << header.a
+                      << ", b = " << header.b << ", dt = " << header.dt << ", not the values given.\n";
+            return 1;
+        }
+        const std::uint32_t scheme = static_cast<std::uint32_t>(options.scheme);
+        if (header.scheme != scheme) {
+            std::cerr << "Error: Checkpoint " << options.checkpointFile << " was written with --scheme " << schemeName(header.scheme)
+                      << ", not " << schemeName(scheme) << ".\n";
+            return 1;
+        }
+        firstStep = static_cast<int>(std::min<std::uint64_t>(header.step, timeSteps));
+        std::cout << "Restarting from time step " << header.step << " of " << options.checkpointFile << "\n";
+    } else {
+        grid = readInitialTemperature(inputFile, N);
+    }
     float dx = (b - a) / (N - 1);
 
     // Perform time-stepping for heat distribution
-    timeStepHeatDistribution(grid, dt, timeSteps, dx);
+    std::unique_ptr<CheckpointWriter> checkpoints;
+    if (options.checkpointEvery > 0) {
+        checkpoints = std::make_unique<CheckpointWriter>(options.checkpointFile, a, b, dt, static_cast<std::uint32_t>(options.scheme),
+                                                         options.keepSnapshots);
+    }
+    timeStepHeatDistribution(grid, dt, timeSteps, dx, options, firstStep, checkpoints.get());
+    if (checkpoints && !checkpoints->finish()) {
+        std::cerr << "Error: Not all checkpoints could be written.\n";
+    }
 
     writeGridToFile(grid, a, b, outputFile);
 
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include "heat_solver.h"
+
+// Function to time one run of the solver, returning the mean and standard deviation over several repetitions
+template <typename Solver>
+void timeSolver(const std::vector<float>& initial, Solver solver, int repeats, std::vector<float>& result, double& meanTime, double& stdTime) {
+    std::vector<double> times;
+    for (int r = 0; r < repeats; ++r) {
+        result = initial;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        solver(result);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double>(endTime - startTime).count());
+    }
+
+    meanTime = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+    stdTime = std::sqrt(std::accumulate(times.begin(), times.end(), 0.0, [meanTime](double sum, double val) { return sum + (val - meanTime) * (val - meanTime); }) / times.size());
+}
+
+// Strong-scaling benchmark of the slab-parallel explicit solver against the serial one.
+// Writes heat_scaling_results.csv and fails if any thread count changes the result.
+int main(int argc, char* argv[]) {
+    if (argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " [number of time steps] [repeats]\n";
+        return 1;
+    }
+    const int timeSteps = argc >= 2 ? std::stoi(argv[1]) : 200;
+    const int repeats = argc == 3 ? std::stoi(argv[2]) : 3;
+    if (timeSteps <= 0 || repeats <= 0) {
+        std::cerr << "Error: The number of time steps and repeats must be positive integers.\n";
+        return 1;
+    }
+
+    const std::vector<std::size_t> sizes = {100000, 1000000, 10000000};
+    const std::vector<int> threadCounts = {1, 2, 4, 8, 16};
+    const float alpha = 0.25f;
+
+    std::ofstream csvFile("heat_scaling_results.csv");
+    csvFile << "N,time_steps,num_threads,mean_time,std_time,speedup,efficiency,points_per_s\n";
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+    bool identical = true;
+
+    for (std::size_t N : sizes) {
+        std::vector<float> initial(N);
+        for (auto& value : initial) {
+            value = distribution(generator);
+        }
+
+        std::vector<float> serial, parallel;
+        double serialTime, stdTime;
+        timeSolver(initial, [&](std::vector<float>& grid) { advanceExplicit(grid, alpha, timeSteps); }, repeats, serial, serialTime, stdTime);
+        std::cout << "N = " << N << ", serial: " << serialTime << " s\n";
+
+        for (int threads : threadCounts) {
+            double meanTime;
+            timeSolver(initial, [&](std::vector<float>& grid) { advanceExplicitParallel(grid, alpha, timeSteps, threads); }, repeats, parallel, meanTime, stdTime);
+
+            if (std::memcmp(serial.data(), parallel.data(), N * sizeof(float)) != 0) {
+                std::cerr << "Error: " << threads << " threads give a different result from the serial solver for N = " << N << "\n";
+                identical = false;
+            }
+
+            double speedup = serialTime / meanTime;
+            csvFile << N << "," << timeSteps << "," << threads << "," << meanTime << "," << stdTime << "," << speedup << ","
+                    << speedup / threads << "," << static_cast<double>(N) * timeSteps / meanTime << "\n";
+            std::cout << "  " << threads << " threads: " << meanTime << " s, speedup " << speedup << "\n";
+        }
+    }
+
+    csvFile.close();
+    std::cout << "Results saved to heat_scaling_results.csv\n";
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include "heat_solver.h"
+
+// Compares the explicit scheme with backward Euler and Crank-Nicolson at larger time steps.
+// The rod on [0, 1] starts as sin(pi x) with both ends at zero, whose exact solution is
+// sin(pi x) exp(-pi^2 t), so each run reports its maximum error at the final time as well as
+// its wall-clock time. Results are written to heat_schemes_results.csv.
+int main(int argc, char* argv[]) {
+    if (argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " [grid size N] [final time]\n";
+        return 1;
+    }
+    const int N = argc >= 2 ? std::stoi(argv[1]) : 2001;
+    const double finalTime = argc == 3 ? std::stod(argv[2]) : 0.02;
+    if (N < 3 || finalTime <= 0) {
+        std::cerr << "Error: The grid size must be at least 3 and the final time positive.\n";
+        return 1;
+    }
+
+    const double pi = std::acos(-1.0);
+    const double dx = 1.0 / (N - 1);
+    std::vector<float> initial(N);
+    for (int i = 0; i < N; ++i) {
+        initial[i] = static_cast<float>(std::sin(pi * i * dx));
+    }
+    initial[0] = 0.0f;
+    initial[N - 1] = 0.0f;
+
+    struct Run {
+        const char* name;
+        TimeScheme scheme;
+        double alpha;
+    };
+    const Run runs[] = {
+        {"explicit", TimeScheme::Explicit, 0.4},
+        {"backward_euler", TimeScheme::BackwardEuler, 0.4},
+        {"backward_euler", TimeScheme::BackwardEuler, 40.0},
+        {"crank_nicolson", TimeScheme::CrankNicolson, 0.4},
+        {"crank_nicolson", TimeScheme::CrankNicolson, 40.0},
+        {"crank_nicolson", TimeScheme::CrankNicolson, 400.0},
+    };
+
+    std::ofstream csvFile("heat_schemes_results.csv");
+    csvFile << "scheme,N,alpha,dt,time_steps,execution_time,max_error\n";
+
+    for (const Run& run : runs) {
+        const int timeSteps = std::max(1, static_cast<int>(std::lround(finalTime / (run.alpha * dx * dx))));
+        const double dt = finalTime / timeSteps;
+        const float alpha = static_cast<float>(dt / (dx * dx));
+
+        std::vector<float> grid = initial;
+        auto startTime = std::chrono::high_resolution_clock::now();
+        if (run.scheme == TimeScheme::Explicit) {
+            advanceExplicit(grid, alpha, timeSteps);
+        } else {
+            ImplicitHeatSolver solver(grid.size(), alpha, run.scheme);
+            solver.advance(grid, timeSteps);
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        double executionTime = std::chrono::duration<double>(endTime - startTime).count();
+
+        double maxError = 0.0;
+        const double decay = std::exp(-pi * pi * finalTime);
+        for (int i = 0; i < N; ++i) {
+            maxError = std::max(maxError, std::abs(grid[i] - std::sin(pi * i * dx) * decay));
+        }
+
+        csvFile << run.name << "," << N << "," << alpha << "," << dt << "," << timeSteps << "," << executionTime << "," << maxError << "\n";
+        std::cout << run.name << " (alpha = " << alpha << ", " << timeSteps << " steps): " << executionTime << " s, max error " << maxError << "\n";
+    }
+
+    csvFile.close();
+    std::cout << "Results saved to heat_schemes_results.csv\n";
+    return 0;
+}
@@ -0,0 +1,406 @@
+#ifndef HEAT_SOLVER_H
+#define HEAT_SOLVER_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include "simd_dispatch.h"
+
+// Tuning knobs for the explicit solver
+struct ExplicitSolverOptions {
+    std::size_t tileSize = 16384; // points per tile; two float buffers of this size stay in L2
+    int stepsPerTile = 32;        // time steps advanced on a tile before moving to the next one
+    int nanCheckInterval = 256;   // time steps between scans of the grid for NaN/Inf
+};
+
+// Explicit update out[i] = in[i] + alpha * (in[i-1] - 2 in[i] + in[i+1]) for i in [begin, end)
+inline void heatStencilScalar(const float* in, float* out, std::size_t begin, std::size_t end, float alpha) {
+    for (std::size_t i = begin; i < end; ++i) {
+        out[i] = in[i] + alpha * (in[i - 1] - 2 * in[i] + in[i + 1]);
+    }
+}
+
+#ifdef SIMD_X86
+
+inline void heatStencilSse(const float* in, float* out, std::size_t begin, std::size_t end, float alpha) {
+    const __m128 valpha = _mm_set1_ps(alpha);
+    const __m128 two = _mm_set1_ps(2.0f);
+    std::size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128 left = _mm_loadu_ps(in + i - 1);
+        __m128 centre = _mm_loadu_ps(in + i);
+        __m128 right = _mm_loadu_ps(in + i + 1);
+        __m128 laplacian = _mm_add_ps(_mm_sub_ps(left, _mm_mul_ps(two, centre)), right);
+        _mm_storeu_ps(out + i, _mm_add_ps(centre, _mm_mul_ps(valpha, laplacian)));
+    }
+    heatStencilScalar(in, out, i, end, alpha);
+}
+
+// The tail uses masked loads and stores rather than scalar code, so every point goes through
+// the same instructions wherever the range is split (tiles, thread slabs).
+SIMD_TARGET_AVX2 inline void heatStencilAvx2(const float* in, float* out, std::size_t begin, std::size_t end, float alpha) {
+    const __m256 valpha = _mm256_set1_ps(alpha);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    std::size_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        __m256 left = _mm256_loadu_ps(in + i - 1);
+        __m256 centre = _mm256_loadu_ps(in + i);
+        __m256 right = _mm256_loadu_ps(in + i + 1);
+        __m256 laplacian = _mm256_add_ps(_mm256_sub_ps(left, _mm256_mul_ps(two, centre)), right);
+        _mm256_storeu_ps(out + i, _mm256_add_ps(centre, _mm256_mul_ps(valpha, laplacian)));
+    }
+    if (i < end) {
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(end - i)),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        __m256 left = _mm256_maskload_ps(in + i - 1, mask);
+        __m256 centre = _mm256_maskload_ps(in + i, mask);
+        __m256 right = _mm256_maskload_ps(in + i + 1, mask);
+        __m256 laplacian = _mm256_add_ps(_mm256_sub_ps(left, _mm256_mul_ps(two, centre)), right);
+        _mm256_maskstore_ps(out + i, mask, _mm256_add_ps(centre, _mm256_mul_ps(valpha, laplacian)));
+    }
+}
+
+#endif // SIMD_X86
+
+// One explicit step for interior points [begin, end), using the widest kernel the CPU supports
+inline void heatStencil(const float* in, float* out, std::size_t begin, std::size_t end, float alpha) {
+    if (begin >= end) {
+        return;
+    }
+#ifdef SIMD_X86
+    switch (active_simd_level()) {
+    case SimdLevel::AVX2:
+        heatStencilAvx2(in, out, begin, end, alpha);
+        return;
+    case SimdLevel::SSE:
+        heatStencilSse(in, out, begin, end, alpha);
+        return;
+    default:
+        break;
+    }
+#endif
+    heatStencilScalar(in, out, begin, end, alpha);
+}
+
+// Index of the first NaN or Inf in data, or n if all values are finite
+inline std::size_t firstNonFinite(const float* data, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!std::isfinite(data[i])) {
+            return i;
+        }
+    }
+    return n;
+}
+
+// Advances the 1D explicit heat equation by timeSteps steps with the end points held fixed.
+//
+// The two grids are swapped after each step instead of copied. Rods longer than one tile are
+// advanced stepsPerTile steps at a time per tile: each tile is loaded with a halo of
+// stepsPerTile points on each side, stepped in cache with a shrinking valid region, and its
+// interior written back, so the rod streams from memory once per stepsPerTile steps. The
+// results are identical to stepping the whole rod one step at a time.
+//
+// Returns false, leaving the non-finite values in grid, if a NaN or Inf is found by the
+// periodic check.
+inline bool advanceExplicit(std::vector<float>& grid, float alpha, int timeSteps,
+                            const ExplicitSolverOptions& options = ExplicitSolverOptions()) {
+    const std::size_t n = grid.size();
+    if (n < 3 || timeSteps <= 0) {
+        return true;
+    }
+
+    const std::size_t tileSize = std::max<std::size_t>(options.tileSize, 1);
+    const int depth = std::max(options.stepsPerTile, 1);
+    const int checkInterval = std::max(options.nanCheckInterval, 1);
+
+    std::vector<float> next = grid;
+    std::vector<float> tile, tileNext;
+    if (tileSize < n) {
+        tile.reserve(tileSize + 2 * depth);
+        tileNext.reserve(tileSize + 2 * depth);
+    }
+
+    int lastCheck = 0;
+    for (int t = 0; t < timeSteps;) {
+        const int steps = std::min(depth, timeSteps - t);
+
+        if (tileSize >= n) {
+            for (int k = 0; k < steps; ++k) {
+                heatStencil(grid.data(), next.data(), 1, n - 1, alpha);
+                grid.swap(next);
+            }
+        } else {
+            for (std::size_t lo = 0; lo < n; lo += tileSize) {
+                const std::size_t hi = std::min(n, lo + tileSize);
+                const std::size_t haloLo = lo >= static_cast<std::size_t>(steps) ? lo - steps : 0;
+                const std::size_t haloHi = std::min(n, hi + steps);
+                const std::size_t width = haloHi - haloLo;
+
+                tile.assign(grid.begin() + haloLo, grid.begin() + haloHi);
+                tileNext.assign(tile.begin(), tile.end());
+                for (int k = 1; k <= steps; ++k) {
+                    // Points within k of a halo edge depend on values outside the tile; the rod ends never change
+                    std::size_t begin = haloLo == 0 ? 1 : static_cast<std::size_t>(k);
+                    std::size_t end = haloHi == n ? width - 1 : width - k;
+                    heatStencil(tile.data(), tileNext.data(), begin, end, alpha);
+                    tile.swap(tileNext);
+                }
+                std::copy(tile.begin() + (lo - haloLo), tile.begin() + (hi - haloLo), next.begin() + lo);
+            }
+            grid.swap(next);
+        }
+
+        t += steps;
+        if (t - lastCheck >= checkInterval || t == timeSteps) {
+            std::size_t bad = firstNonFinite(grid.data(), n);
+            if (bad != n) {
+                std::cerr << "NaN detected between time steps " << lastCheck << " and " << t << ", index " << bad << "\n";
+                return false;
+            }
+            lastCheck = t;
+        }
+    }
+    return true;
+}
+
+// Time discretizations offered by heat_distribution
+enum class TimeScheme {
+    Explicit,      // forward Euler, stable only for alpha <= 0.5
+    BackwardEuler, // implicit, unconditionally stable and monotone, first order in time
+    CrankNicolson  // implicit, unconditionally stable, second order in time; may ring for very large alpha
+};
+
+// Implicit solver for the 1D heat equation with the end points held fixed.
+//
+// Each step solves the tridiagonal system
+//     -lambda u[i-1] + (1 + 2 lambda) u[i] - lambda u[i+1] = rhs[i]
+// with lambda = alpha (backward Euler) or alpha / 2 (Crank-Nicolson) by the Thomas algorithm.
+// The matrix does not change between steps, so its elimination factors are computed once in
+// the constructor; a step is then one forward sweep, which builds the right-hand side from
+// the old values on the fly, and one back substitution that overwrites the grid in place.
+// All buffers are allocated once. The factors and the sweep are kept in double: a float
+// rounding of the factors biases every step the same way and compounds over long runs.
+class ImplicitHeatSolver {
+public:
+    ImplicitHeatSolver(std::size_t n, float alpha, TimeScheme scheme)
+        : n_(n), scheme_(scheme),
+          lambda_(scheme == TimeScheme::CrankNicolson ? 0.5 * alpha : static_cast<double>(alpha)),
+          cPrime_(n, 0.0), invPivot_(n, 0.0), dPrime_(n, 0.0) {
+        // Elimination factors for the interior rows 1..n-2
+        for (std::size_t i = 1; i + 1 < n; ++i) {
+            double pivot = 1.0 + 2.0 * lambda_ + lambda_ * cPrime_[i - 1];
+            invPivot_[i] = 1.0 / pivot;
+            cPrime_[i] = -lambda_ / pivot;
+        }
+    }
+
+    std::size_t size() const { return n_; }
+
+    // Advances grid (of the size given to the constructor) by timeSteps implicit steps.
+    // Returns false, leaving the non-finite values in grid, if a NaN or Inf is found by the
+    // check run every nanCheckInterval steps.
+    bool advance(std::vector<float>& grid, int timeSteps, int nanCheckInterval = 256) {
+        if (grid.size() != n_ || n_ < 3 || timeSteps <= 0) {
+            return grid.size() == n_;
+        }
+        const int checkInterval = std::max(nanCheckInterval, 1);
+
+        int lastCheck = 0;
+        for (int t = 1; t <= timeSteps; ++t) {
+            step(grid.data());
+            if (t - lastCheck >= checkInterval || t == timeSteps) {
+                std::size_t bad = firstNonFinite(grid.data(), n_);
+                if (bad != n_) {
+                    std::cerr << "NaN detected between time steps " << lastCheck << " and " << t << ", index " << bad << "\n";
+                    return false;
+                }
+                lastCheck = t;
+            }
+        }
+        return true;
+    }
+
+private:
+    void step(float* u) {
+        const double lambda = lambda_;
+        const double* cPrime = cPrime_.data();
+        const double* invPivot = invPivot_.data();
+        double* dPrime = dPrime_.data();
+        const std::size_t last = n_ - 2;
+
+        // Forward sweep; u still holds the old values. The fixed end points enter the first
+        // and last rows on the right-hand side.
+        double carry = lambda * u[0];
+        if (scheme_ == TimeScheme::CrankNicolson) {
+            const double centre = 1.0 - 2.0 * lambda;
+            for (std::size_t i = 1; i <= last; ++i) {
+                double rhs = lambda * u[i - 1] + centre * u[i] + lambda * u[i + 1];
+                if (i == last) {
+                    rhs += lambda * u[n_ - 1];
+                }
+                dPrime[i] = (rhs + carry) * invPivot[i];
+                carry = lambda * dPrime[i];
+            }
+        } else {
+            for (std::size_t i = 1; i <= last; ++i) {
+                double rhs = u[i];
+                if (i == last) {
+                    rhs += lambda * u[n_ - 1];
+                }
+                dPrime[i] = (rhs + carry) * invPivot[i];
+                carry = lambda * dPrime[i];
+            }
+        }
+
+        // Back substitution, writing the new values in place
+        double next = dPrime[last];
+        u[last] = static_cast<float>(next);
+        for (std::size_t i = last; i-- > 1;) {
+            next = dPrime[i] - cPrime[i] * next;
+            u[i] = static_cast<float>(next);
+        }
+    }
+
+    std::size_t n_;
+    TimeScheme scheme_;
+    double lambda_;
+    std::vector<double> cPrime_;   // super-diagonal after elimination
+    std::vector<double> invPivot_; // reciprocal of the eliminated diagonal
+    std::vector<double> dPrime_;   // right-hand side after elimination
+};
+
+// Waits until pred() holds, spinning briefly before yielding so oversubscribed runs still progress
+template <typename Predicate>
+inline void spinUntil(Predicate pred) {
+    for (int spins = 0; !pred(); ++spins) {
+        if (spins >= 64) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// Sense-reversing barrier for a fixed number of threads, built on one atomic counter
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int count) : count_(count), waiting_(0), generation_(0) {}
+
+    void wait() {
+        const int generation = generation_.load(std::memory_order_acquire);
+        if (waiting_.fetch_add(1, std::memory_order_acq_rel) == count_ - 1) {
+            waiting_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+            return;
+        }
+        spinUntil([&] { return generation_.load(std::memory_order_acquire) != generation; });
+    }
+
+private:
+    const int count_;
+    std::atomic<int> waiting_;
+    std::atomic<int> generation_;
+};
+
+// Edge cells a slab publishes to its neighbours, double-buffered by step parity.
+// Padded to a cache line so that neighbouring slabs do not falsely share.
+struct alignas(64) SlabEdges {
+    std::atomic<int> published{-1}; // last step whose edge cells are in first/last
+    float first[2];
+    float last[2];
+};
+
+// Multithreaded version of advanceExplicit. The rod is split into one slab per thread; each
+// thread steps its slab in a private buffer with one ghost cell per side. After every step a
+// thread publishes its two edge cells and waits only for its two neighbours' flags, so there
+// is no global synchronization except a barrier every nanCheckInterval steps to agree on the
+// NaN check. The stencil is the same as in the serial solver, so the results are bit-identical.
+inline bool advanceExplicitParallel(std::vector<float>& grid, float alpha, int timeSteps, int numThreads,
+                                    const ExplicitSolverOptions& options = ExplicitSolverOptions()) {
+    const std::size_t n = grid.size();
+    const int threads = static_cast<int>(std::min<std::size_t>(std::max(numThreads, 1), n));
+    if (threads <= 1 || n < 3 || timeSteps <= 0) {
+        return advanceExplicit(grid, alpha, timeSteps, options);
+    }
+    const int checkInterval = std::max(options.nanCheckInterval, 1);
+
+    std::vector<SlabEdges> edges(threads);
+    SpinBarrier barrier(threads);
+    std::atomic<bool> nonFinite(false);
+    std::vector<int> stepsDone(threads, 0);
+
+    auto worker = [&](int t) {
+        const std::size_t begin = n * t / threads;
+        const std::size_t end = n * (t + 1) / threads;
+        const std::size_t m = end - begin;
+
+        // Local index l holds global index begin + l - 1; 0 and m + 1 are the ghost cells
+        std::vector<float> cur(m + 2, 0.0f);
+        std::copy(grid.begin() + begin, grid.begin() + end, cur.begin() + 1);
+        if (t > 0) {
+            cur[0] = grid[begin - 1];
+        }
+        if (t < threads - 1) {
+            cur[m + 1] = grid[end];
+        }
+        std::vector<float> next = cur;
+
+        // The rod ends (global 0 and n - 1) are never updated
+        const std::size_t localBegin = std::max<std::size_t>(begin, 1) - begin + 1;
+        const std::size_t localEnd = std::min(end, n - 1) - begin + 1;
+
+        int k = 0;
+        while (k < timeSteps) {
+            heatStencil(cur.data(), next.data(), localBegin, localEnd, alpha);
+            cur.swap(next);
+
+            const int slot = k & 1;
+            edges[t].first[slot] = cur[1];
+            edges[t].last[slot] = cur[m];
+            edges[t].published.store(k, std::memory_order_release);
+            if (t > 0) {
+                spinUntil([&] { return edges[t - 1].published.load(std::memory_order_acquire) >= k; });
+                cur[0] = edges[t - 1].last[slot];
+            }
+            if (t < threads - 1) {
+                spinUntil([&] { return edges[t + 1].published.load(std::memory_order_acquire) >= k; });
+                cur[m + 1] = edges[t + 1].first[slot];
+            }
+            ++k;
+
+            if (k % checkInterval == 0 || k == timeSteps) {
+                if (firstNonFinite(cur.data() + 1, m) != m) {
+                    nonFinite.store(true, std::memory_order_relaxed);
+                }
+                barrier.wait();
+                if (nonFinite.load(std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+        }
+
+        std::copy(cur.begin() + 1, cur.begin() + 1 + m, grid.begin() + begin);
+        stepsDone[t] = k;
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    if (nonFinite.load()) {
+        std::size_t bad = firstNonFinite(grid.data(), n);
+        std::cerr << "NaN detected by time step " << stepsDone[0] << ", index " << bad << "\n";
+        return false;
+    }
+    return true;
+}
+
+#endif // HEAT_SOLVER_H
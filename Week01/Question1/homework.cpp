@@ -6,128 +6,104 @@
 #include <optional>
 #include <filesystem>
 #include <sstream>
+#include "temperature_io.h"
+#include "normalize_kernels.h"
+#include "temperature_stream.h"
+#include "temperature_binary.h"
 
 /**
- * Normalizes the temperature values in the given vector.
+ * Computes the scale and offset that map the range of the given values onto [Tmin, Tmax].
  *
  * @param T The vector of temperature values to be normalized.
  * @param Tmin The minimum desired temperature value.
  * @param Tmax The maximum desired temperature value.
- * @return The vector of normalized temperature values.
+ * @param scale Set to (Tmax - Tmin) / (T_max - T_min).
+ * @param offset Set to Tmin - T_min * scale.
+ * @return true on success, false if the vector is empty or all values are the same.
  */
-std::optional<std::vector<float>> normalize_temperature(const std::vector<float>& T, float Tmin, float Tmax)
+bool normalization_coefficients(const std::vector<float>& T, float Tmin, float Tmax, float& scale, float& offset)
 {
     if (T.empty())
     {
         std::cerr << "Error: Empty temperature vector provided for normalization." << std::endl;
-        return std::nullopt;
+        return false;
     }
 
-    float T_min = *std::min_element(T.begin(), T.end());
-    float T_max = *std::max_element(T.begin(), T.end());
+    float T_min, T_max;
+    find_min_max(T.data(), T.size(), T_min, T_max);
 
     if (T_min == T_max)
     {
         std::cerr << "Error: All temperature values are the same. Normalization is not possible." << std::endl;
-        return std::nullopt;
+        return false;
     }
 
-    std::vector<float> normalized_T;
-    normalized_T.reserve(T.size());
-    for (const auto& temp : T)
-    {
-        normalized_T.push_back(Tmin + (temp - T_min) * (Tmax - Tmin) / (T_max - T_min));
-    }
-
-    return normalized_T;
+    scale = (Tmax - Tmin) / (T_max - T_min);
+    offset = Tmin - T_min * scale;
+    return true;
 }
 
 /**
- * Reads a temperature profile from a CSV file.
+ * Normalizes the temperature values in the given vector.
  *
- * @param filename The name of the file to read the temperature profile from.
- * @return A vector of floats representing the temperature profile read from the file, or nullopt on failure.
+ * @param T The vector of temperature values to be normalized.
+ * @param Tmin The minimum desired temperature value.
+ * @param Tmax The maximum desired temperature value.
+ * @return The vector of normalized temperature values.
  */
-std::optional<std::vector<float>> read_temperature_profile(const std::string& filename)
+std::optional<std::vector<float>> normalize_temperature(const std::vector<float>& T, float Tmin, float Tmax)
 {
-    if (!std::filesystem::exists(filename))
+    float scale, offset;
+    if (!normalization_coefficients(T, Tmin, Tmax, scale, offset))
     {
-        std::cerr << "Error: File does not exist: " << filename << std::endl;
         return std::nullopt;
     }
 
-    std::ifstream temp_in(filename);
-    if (!temp_in.is_open())
-    {
-        std::cerr << "Error opening file: " << filename << std::endl;
-        return std::nullopt;
-    }
-
-    std::vector<float> T;
-    std::string line;
-    while (std::getline(temp_in, line))
-    {
-        std::stringstream ss(line);
-        std::string temp_str;
-        while (std::getline(ss, temp_str, ','))
-        {
-            try
-            {
-                T.push_back(std::stof(temp_str));
-            }
-            catch (const std::invalid_argument& e)
-            {
-                std::cerr << "Invalid data in file: " << filename << std::endl;
-                return std::nullopt;
-            }
-        }
-    }
-
-    if (T.empty())
-    {
-        std::cerr << "Error: No temperature data found in file: " << filename << std::endl;
-        return std::nullopt;
-    }
+    std::vector<float> normalized_T(T.size());
+    apply_scale_offset(T.data(), normalized_T.data(), T.size(), scale, offset);
 
-    return T;
+    return normalized_T;
 }
 
 /**
- * Writes the normalized temperature profile to a file.
+ * Normalizes the temperature values in the given vector in place, without a second buffer.
  *
- * @param filename The name of the file to write the normalized temperature profile to.
- * @param T The vector of normalized temperature values.
+ * @param T The vector of temperature values to be normalized; overwritten with the result.
+ * @param Tmin The minimum desired temperature value.
+ * @param Tmax The maximum desired temperature value.
+ * @return true on success, false if the vector is left unchanged.
  */
-void write_normalized_temperature_profile(const std::string& filename, const std::vector<float>& T)
+bool normalize_temperature_in_place(std::vector<float>& T, float Tmin, float Tmax)
 {
-    std::ofstream outfile(filename);
-    if (!outfile.is_open())
-    {
-        std::cerr << "Error opening file for writing: " << filename << std::endl;
-        return;
-    }
-
-    for (const auto& temp : T)
+    float scale, offset;
+    if (!normalization_coefficients(T, Tmin, Tmax, scale, offset))
     {
-        outfile << temp << std::endl;
+        return false;
     }
 
-    if (outfile.fail())
-    {
-        std::cerr << "Error writing to file: " << filename << std::endl;
-    }
+    apply_scale_offset(T.data(), T.data(), T.size(), scale, offset);
+    return true;
 }
 
 /**
  * @brief Main function that reads a temperature profile from a file, normalizes it, and writes the normalized values to a file.
  *
+ * The file is read through a memory mapping by default; --legacy-reader selects the
+ * original getline/stof reader and --threads N the parallel chunked reader
+ * (N = 0 uses all hardware threads). --stream normalizes the file in two passes over
+ * blocks of --block-size bytes, so files larger than memory can be processed. --binary
+ * writes normalized_temperature.bin in the binary format instead of the text file.
+ * Input files in the binary format (e.g. from generate_csv --binary) are detected and
+ * read directly by the default reader and by --stream; --legacy-reader and --threads parse
+ * CSV only and reject them.
+ *
  * @return int The exit status of the program.
  */
 int main(int argc, char* argv[])
 {
-    if (argc != 4)
+    if (argc < 4)
     {
-        std::cerr << "Usage: " << argv[0] << " <filename> <Tmin> <Tmax>" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " <filename> <Tmin> <Tmax> [--legacy-reader] [--threads N] [--stream] [--block-size BYTES] [--binary]" << std::endl;
         return 1;
     }
 
@@ -135,7 +111,92 @@ int main(int argc, char* argv[])
     float Tmin = std::stof(argv[2]);
     float Tmax = std::stof(argv[3]);
 
-    auto T_opt = read_temperature_profile(filename);
+    bool legacy_reader = false;
+    int num_threads = -1;
+    bool streaming = false;
+    std::size_t block_bytes = 16 << 20;
+    bool binary = false;
+    for (int i = 4; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if (option == "--legacy-reader")
+        {
+            legacy_reader = true;
+        }
+        else if (option == "--threads" && i + 1 < argc)
+        {
+            num_threads = std::stoi(argv[++i]);
+        }
+        else if (option == "--stream")
+        {
+            streaming = true;
+        }
+        else if (option == "--binary")
+        {
+            binary = true;
+        }
+        else if (option == "--block-size" && i + 1 < argc)
+        {
+            long long bytes = std::stoll(argv[++i]);
+            if (bytes <= 0)
+            {
+                std::cerr << "Error: The block size must be a positive number of bytes." << std::endl;
+                return 1;
+            }
+            block_bytes = static_cast<std::size_t>(bytes);
+        }
+        else
+        {
+            std::cerr << "Error: Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+
+    const std::string output_filename = binary ? "normalized_temperature.bin" : "normalized_temperature.txt";
+
+    if ((legacy_reader || num_threads >= 0) && is_temperature_binary_file(filename))
+    {
+        std::cerr << "Error: " << filename << " is a binary temperature profile; --legacy-reader and --threads read CSV files only." << std::endl;
+        return 1;
+    }
+
+    if (streaming)
+    {
+        if (legacy_reader || num_threads >= 0)
+        {
+            std::cerr << "Error: --stream cannot be combined with --legacy-reader or --threads." << std::endl;
+            return 1;
+        }
+
+        std::size_t count = 0;
+        if (!normalize_temperature_file_streaming(filename, output_filename, Tmin, Tmax, block_bytes, binary, count))
+        {
+            std::cerr << "Streaming normalization failed. Exiting program." << std::endl;
+            return 1;
+        }
+
+        std::cout << "Read " << count << " temperature values." << std::endl;
+        std::cout << "Normalized temperature profile written to '" << output_filename << "'." << std::endl;
+        return 0;
+    }
+
+    std::optional<std::vector<float>> T_opt;
+    if (legacy_reader)
+    {
+        T_opt = read_temperature_profile(filename);
+    }
+    else if (num_threads >= 0)
+    {
+        T_opt = read_temperature_profile_parallel(filename, num_threads);
+    }
+    else if (is_temperature_binary_file(filename))
+    {
+        T_opt = read_temperature_profile_binary(filename);
+    }
+    else
+    {
+        T_opt = read_temperature_profile_mapped(filename);
+    }
 
     if (!T_opt)
     {
@@ -147,17 +208,26 @@ int main(int argc, char* argv[])
 
     std::cout << "Read " << T.size() << " temperature values." << std::endl;
 
-    auto normalized_T_opt = normalize_temperature(T, Tmin, Tmax);
-
-    if (!normalized_T_opt)
+    // T is not needed afterwards, so normalize it in place rather than holding two copies
+    if (!normalize_temperature_in_place(T, Tmin, Tmax))
     {
         std::cerr << "Normalization failed. Exiting program." << std::endl;
         return 1;
     }
 
-    write_normalized_temperature_profile("normalized_temperature.txt", *normalized_T_opt);
+    if (binary)
+    {
+        if (!write_normalized_temperature_binary(output_filename, T, Tmin, Tmax))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        write_normalized_temperature_profile(output_filename, T);
+    }
 
-    std::cout << "Normalized temperature profile written to 'normalized_temperature.txt'." << std::endl;
+    std::cout << "Normalized temperature profile written to '" << output_filename << "'." << std::endl;
 
     return 0;
 }
\ No newline at end of file
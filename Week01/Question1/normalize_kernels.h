@@ -0,0 +1,168 @@
+#ifndef NORMALIZE_KERNELS_H
+#define NORMALIZE_KERNELS_H
+
+#include <cstddef>
+#include "simd_dispatch.h"
+
+// Scalar fallbacks, also used for the tails of the vector kernels
+
+inline void min_max_scalar(const float* data, std::size_t n, float& lo, float& hi)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        lo = data[i] < lo ? data[i] : lo;
+        hi = data[i] > hi ? data[i] : hi;
+    }
+}
+
+inline void scale_offset_scalar(const float* in, float* out, std::size_t n, float scale, float offset)
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        out[i] = in[i] * scale + offset;
+    }
+}
+
+#ifdef SIMD_X86
+
+inline void min_max_sse(const float* data, std::size_t n, float& lo, float& hi)
+{
+    std::size_t i = 0;
+    if (n >= 4)
+    {
+        __m128 vlo = _mm_loadu_ps(data);
+        __m128 vhi = vlo;
+        for (i = 4; i + 4 <= n; i += 4)
+        {
+            __m128 v = _mm_loadu_ps(data + i);
+            vlo = _mm_min_ps(vlo, v);
+            vhi = _mm_max_ps(vhi, v);
+        }
+        alignas(16) float lanes_lo[4], lanes_hi[4];
+        _mm_store_ps(lanes_lo, vlo);
+        _mm_store_ps(lanes_hi, vhi);
+        min_max_scalar(lanes_lo, 4, lo, hi);
+        min_max_scalar(lanes_hi, 4, lo, hi);
+    }
+    min_max_scalar(data + i, n - i, lo, hi);
+}
+
+inline void scale_offset_sse(const float* in, float* out, std::size_t n, float scale, float offset)
+{
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voffset = _mm_set1_ps(offset);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in + i), vscale), voffset));
+    }
+    scale_offset_scalar(in + i, out + i, n - i, scale, offset);
+}
+
+SIMD_TARGET_AVX2 inline void min_max_avx2(const float* data, std::size_t n, float& lo, float& hi)
+{
+    std::size_t i = 0;
+    if (n >= 16)
+    {
+        // Two independent accumulator pairs hide the latency of vminps/vmaxps
+        __m256 vlo0 = _mm256_loadu_ps(data);
+        __m256 vhi0 = vlo0;
+        __m256 vlo1 = _mm256_loadu_ps(data + 8);
+        __m256 vhi1 = vlo1;
+        for (i = 16; i + 16 <= n; i += 16)
+        {
+            __m256 v0 = _mm256_loadu_ps(data + i);
+            __m256 v1 = _mm256_loadu_ps(data + i + 8);
+            vlo0 = _mm256_min_ps(vlo0, v0);
+            vhi0 = _mm256_max_ps(vhi0, v0);
+            vlo1 = _mm256_min_ps(vlo1, v1);
+            vhi1 = _mm256_max_ps(vhi1, v1);
+        }
+        alignas(32) float lanes_lo[8], lanes_hi[8];
+        _mm256_store_ps(lanes_lo, _mm256_min_ps(vlo0, vlo1));
+        _mm256_store_ps(lanes_hi, _mm256_max_ps(vhi0, vhi1));
+        min_max_scalar(lanes_lo, 8, lo, hi);
+        min_max_scalar(lanes_hi, 8, lo, hi);
+    }
+    min_max_scalar(data + i, n - i, lo, hi);
+}
+
+SIMD_TARGET_AVX2 inline void scale_offset_avx2(const float* in, float* out, std::size_t n, float scale, float offset)
+{
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 voffset = _mm256_set1_ps(offset);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        _mm256_storeu_ps(out + i, _mm256_fmadd_ps(_mm256_loadu_ps(in + i), vscale, voffset));
+    }
+    if (i < n)
+    {
+        // The last 1..7 values go through the same fused multiply-add under a mask, so a value
+        // is rounded the same way wherever it sits in the array
+        const __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n - i)),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        const __m256 v = _mm256_maskload_ps(in + i, mask);
+        _mm256_maskstore_ps(out + i, mask, _mm256_fmadd_ps(v, vscale, voffset));
+    }
+}
+
+#endif // SIMD_X86
+
+/**
+ * Finds the minimum and maximum of an array in a single pass.
+ *
+ * @param data Pointer to the values.
+ * @param n The number of values; must be positive.
+ * @param lo Set to the minimum value.
+ * @param hi Set to the maximum value.
+ */
+inline void find_min_max(const float* data, std::size_t n, float& lo, float& hi)
+{
+    lo = data[0];
+    hi = data[0];
+#ifdef SIMD_X86
+    switch (active_simd_level())
+    {
+    case SimdLevel::AVX2:
+        min_max_avx2(data, n, lo, hi);
+        return;
+    case SimdLevel::SSE:
+        min_max_sse(data, n, lo, hi);
+        return;
+    default:
+        break;
+    }
+#endif
+    min_max_scalar(data, n, lo, hi);
+}
+
+/**
+ * Computes out[i] = in[i] * scale + offset, fused into an FMA where the CPU supports it.
+ * in and out may point to the same array.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n The number of values.
+ * @param scale The factor applied to every value.
+ * @param offset The offset added to every scaled value.
+ */
+inline void apply_scale_offset(const float* in, float* out, std::size_t n, float scale, float offset)
+{
+#ifdef SIMD_X86
+    switch (active_simd_level())
+    {
+    case SimdLevel::AVX2:
+        scale_offset_avx2(in, out, n, scale, offset);
+        return;
+    case SimdLevel::SSE:
+        scale_offset_sse(in, out, n, scale, offset);
+        return;
+    default:
+        break;
+    }
+#endif
+    scale_offset_scalar(in, out, n, scale, offset);
+}
+
+#endif // NORMALIZE_KERNELS_H
@@ -0,0 +1,73 @@
+#ifndef SIMD_DISPATCH_H
+#define SIMD_DISPATCH_H
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2/FMA instructions inside functions compiled for that target;
+// MSVC accepts the intrinsics anywhere.
+#if defined(SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define SIMD_TARGET_AVX2
+#endif
+
+// Instruction sets the SIMD kernels in this directory are implemented for
+enum class SimdLevel
+{
+    Scalar,
+    SSE,
+    AVX2
+};
+
+/**
+ * Detects the widest instruction set supported by both the CPU and the operating system.
+ *
+ * @return The detected SIMD level.
+ */
+inline SimdLevel detect_simd_level()
+{
+#if !defined(SIMD_X86)
+    return SimdLevel::Scalar;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return SimdLevel::SSE;
+    }
+    __cpuid(info, 1);
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!fma || !osxsave || !avx || (_xgetbv(0) & 6) != 6)
+    {
+        return SimdLevel::SSE;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0 ? SimdLevel::AVX2 : SimdLevel::SSE;
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return SimdLevel::AVX2;
+    }
+    return SimdLevel::SSE;
+#endif
+}
+
+/**
+ * Returns the SIMD level used by the kernels, detected once per process.
+ */
+inline SimdLevel active_simd_level()
+{
+    static const SimdLevel level = detect_simd_level();
+    return level;
+}
+
+#endif // SIMD_DISPATCH_H
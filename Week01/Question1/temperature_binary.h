@@ -0,0 +1,231 @@
+#ifndef TEMPERATURE_BINARY_H
+#define TEMPERATURE_BINARY_H
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+#include "../../common/byte_order.h"
+#include "../../common/mapped_file.h"
+
+/**
+ * Binary temperature profile layout, all fields little-endian:
+ *
+ *   offset  size  field
+ *        0     4  magic "TPRF"
+ *        4     2  format version (1)
+ *        6     2  dtype (1 = float32)
+ *        8     8  number of values
+ *       16     4  Tmin, the smallest value
+ *       20     4  Tmax, the largest value
+ *       24   4*n  values
+ *
+ * Tmin and Tmax give the range of the values whoever wrote the file: for a normalized profile
+ * it is the range normalized to, for raw generated data the actual minimum and maximum, and
+ * 0, 0 for an empty profile.
+ *
+ * The header is 24 bytes so the values stay 8-byte aligned in a memory mapping.
+ */
+constexpr char temperature_binary_magic[4] = {'T', 'P', 'R', 'F'};
+constexpr std::uint16_t temperature_binary_version = 1;
+constexpr std::uint16_t temperature_dtype_float32 = 1;
+constexpr std::size_t temperature_binary_header_size = 24;
+
+// Stores value at dst in little-endian byte order, whatever the host order
+template <typename T>
+inline void store_little_endian(unsigned char* dst, T value)
+{
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        dst[i] = host_is_little_endian() ? bytes[i] : bytes[sizeof(T) - 1 - i];
+    }
+}
+
+// Loads a little-endian value from src, whatever the host order
+template <typename T>
+inline T load_little_endian(const unsigned char* src)
+{
+    unsigned char bytes[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        bytes[i] = host_is_little_endian() ? src[i] : src[sizeof(T) - 1 - i];
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/**
+ * Fills a binary temperature profile header.
+ *
+ * @param header The 24-byte header buffer to fill.
+ * @param count The number of values that follow the header.
+ * @param Tmin The smallest value of the profile.
+ * @param Tmax The largest value of the profile.
+ */
+inline void fill_temperature_binary_header(unsigned char* header, std::uint64_t count, float Tmin, float Tmax)
+{
+    std::memcpy(header, temperature_binary_magic, 4);
+    store_little_endian<std::uint16_t>(header + 4, temperature_binary_version);
+    store_little_endian<std::uint16_t>(header + 6, temperature_dtype_float32);
+    store_little_endian<std::uint64_t>(header + 8, count);
+    store_little_endian<float>(header + 16, Tmin);
+    store_little_endian<float>(header + 20, Tmax);
+}
+
+/**
+ * Writes raw float32 values in little-endian byte order.
+ *
+ * On little-endian hosts this is a single bulk write; otherwise the values are swapped first.
+ *
+ * @param out The stream to write to.
+ * @param values Pointer to the values.
+ * @param n The number of values.
+ */
+inline void write_float32_little_endian(std::ostream& out, const float* values, std::size_t n)
+{
+    if (host_is_little_endian())
+    {
+        out.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(n * sizeof(float)));
+        return;
+    }
+    std::vector<unsigned char> swapped(n * sizeof(float));
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        store_little_endian<float>(swapped.data() + i * sizeof(float), values[i]);
+    }
+    out.write(reinterpret_cast<const char*>(swapped.data()), static_cast<std::streamsize>(swapped.size()));
+}
+
+/**
+ * Writes the normalized temperature profile in the binary format described above.
+ *
+ * @param filename The name of the file to write the normalized temperature profile to.
+ * @param T The vector of normalized temperature values.
+ * @param Tmin The minimum temperature value used for the normalization.
+ * @param Tmax The maximum temperature value used for the normalization.
+ * @return true on success, false if the file cannot be opened or written.
+ */
+inline bool write_normalized_temperature_binary(const std::string& filename, const std::vector<float>& T, float Tmin, float Tmax)
+{
+    std::ofstream outfile(filename, std::ios::binary);
+    if (!outfile.is_open())
+    {
+        std::cerr << "Error opening file for writing: " << filename << std::endl;
+        return false;
+    }
+
+    unsigned char header[temperature_binary_header_size];
+    fill_temperature_binary_header(header, T.size(), Tmin, Tmax);
+    outfile.write(reinterpret_cast<const char*>(header), sizeof(header));
+    write_float32_little_endian(outfile, T.data(), T.size());
+
+    outfile.close();
+    if (outfile.fail())
+    {
+        std::cerr << "Error writing to file: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Read-only, zero-copy view of a binary temperature profile through a memory mapping.
+ */
+class MappedTemperatureProfile
+{
+public:
+    /**
+     * Maps the file and validates its header.
+     *
+     * @param filename The name of the binary temperature profile to open.
+     * @return true if the file is a valid float32 profile that can be used in place on this host.
+     */
+    bool open(const std::string& filename)
+    {
+        count_ = 0;
+        if (!file_.open(filename))
+        {
+            std::cerr << "Error opening file: " << filename << std::endl;
+            return false;
+        }
+
+        const auto* bytes = reinterpret_cast<const unsigned char*>(file_.data());
+        if (file_.size() < temperature_binary_header_size || std::memcmp(bytes, temperature_binary_magic, 4) != 0)
+        {
+            std::cerr << "Error: Not a binary temperature profile: " << filename << std::endl;
+            return false;
+        }
+        if (load_little_endian<std::uint16_t>(bytes + 4) != temperature_binary_version ||
+            load_little_endian<std::uint16_t>(bytes + 6) != temperature_dtype_float32)
+        {
+            std::cerr << "Error: Unsupported version or data type in file: " << filename << std::endl;
+            return false;
+        }
+        if (!host_is_little_endian())
+        {
+            std::cerr << "Error: Binary temperature profiles cannot be mapped in place on a big-endian host." << std::endl;
+            return false;
+        }
+
+        const std::uint64_t count = load_little_endian<std::uint64_t>(bytes + 8);
+        if (count > (file_.size() - temperature_binary_header_size) / sizeof(float))
+        {
+            std::cerr << "Error: Truncated binary temperature profile: " << filename << std::endl;
+            return false;
+        }
+
+        count_ = static_cast<std::size_t>(count);
+        Tmin_ = load_little_endian<float>(bytes + 16);
+        Tmax_ = load_little_endian<float>(bytes + 20);
+        return true;
+    }
+
+    const float* data() const { return reinterpret_cast<const float*>(file_.data() + temperature_binary_header_size); }
+    std::size_t size() const { return count_; }
+    float Tmin() const { return Tmin_; }
+    float Tmax() const { return Tmax_; }
+
+private:
+    MappedFile file_;
+    std::size_t count_ = 0;
+    float Tmin_ = 0.0f;
+    float Tmax_ = 0.0f;
+};
+
+/**
+ * Checks whether a file starts with the binary temperature profile magic.
+ *
+ * @param filename The name of the file to check.
+ * @return true if the file can be opened and starts with "TPRF".
+ */
+inline bool is_temperature_binary_file(const std::string& filename)
+{
+    std::ifstream infile(filename, std::ios::binary);
+    char magic[4];
+    return infile.read(magic, sizeof(magic)) && std::memcmp(magic, temperature_binary_magic, 4) == 0;
+}
+
+/**
+ * Reads a binary temperature profile into memory.
+ *
+ * @param filename The name of the binary temperature profile to read.
+ * @return The temperature values, or std::nullopt if the file is not a valid profile.
+ */
+inline std::optional<std::vector<float>> read_temperature_profile_binary(const std::string& filename)
+{
+    MappedTemperatureProfile profile;
+    if (!profile.open(filename))
+    {
+        return std::nullopt;
+    }
+    return std::vector<float>(profile.data(), profile.data() + profile.size());
+}
+
+#endif // TEMPERATURE_BINARY_H
@@ -0,0 +1,361 @@
+#ifndef TEMPERATURE_IO_H
+#define TEMPERATURE_IO_H
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <algorithm>
+#include <optional>
+#include <charconv>
+#include <cstddef>
+#include <system_error>
+#include "../../common/mapped_file.h"
+#include "../../common/buffered_text_writer.h"
+
+/**
+ * Counts an upper bound on the number of values in a CSV buffer.
+ *
+ * Every value is followed by a comma, a newline or the end of the buffer, so the
+ * number of separators plus one is never smaller than the number of values.
+ *
+ * @param begin Pointer to the first byte of the buffer.
+ * @param end Pointer one past the last byte of the buffer.
+ * @return The upper bound on the number of values.
+ */
+inline std::size_t count_csv_values(const char* begin, const char* end)
+{
+    std::size_t count = 1;
+    for (const char* p = begin; p != end; ++p)
+    {
+        count += (*p == ',') | (*p == '\n');
+    }
+    return count;
+}
+
+/**
+ * Parses comma/newline separated temperature values in place, without allocating per token.
+ *
+ * Blanks around values, blank lines and a trailing comma at the end of a line are accepted.
+ * Anything else that std::from_chars cannot consume as a float is reported as malformed.
+ *
+ * @param base Pointer to the start of the file contents; offsets are relative to it.
+ * @param begin Byte offset of the first byte to parse.
+ * @param end Byte offset one past the last byte to parse.
+ * @param T The vector the parsed values are appended to.
+ * @param error_offset Set to the byte offset of the malformed token on failure.
+ * @return true on success, false if a malformed token was found.
+ */
+inline bool parse_temperature_csv(const char* base, std::size_t begin, std::size_t end,
+                                  std::vector<float>& T, std::size_t& error_offset)
+{
+    const char* p = base + begin;
+    const char* last = base + end;
+
+    while (true)
+    {
+        while (p != last && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        {
+            ++p;
+        }
+        if (p == last)
+        {
+            return true;
+        }
+
+        // std::stof accepted an explicit plus sign, std::from_chars does not
+        const char* token = p;
+        if (*p == '+')
+        {
+            ++p;
+        }
+
+        float value;
+        auto [ptr, ec] = std::from_chars(p, last, value);
+        if (ec != std::errc())
+        {
+            error_offset = static_cast<std::size_t>(token - base);
+            return false;
+        }
+        T.push_back(value);
+        p = ptr;
+
+        while (p != last && (*p == ' ' || *p == '\t' || *p == '\r'))
+        {
+            ++p;
+        }
+        if (p == last)
+        {
+            return true;
+        }
+        if (*p != ',' && *p != '\n')
+        {
+            error_offset = static_cast<std::size_t>(token - base);
+            return false;
+        }
+        ++p;
+    }
+}
+
+/**
+ * Reads a temperature profile from a CSV file, one std::getline and std::stof per value.
+ *
+ * @param filename The name of the file to read the temperature profile from.
+ * @return A vector of floats representing the temperature profile read from the file, or nullopt on failure.
+ */
+inline std::optional<std::vector<float>> read_temperature_profile(const std::string& filename)
+{
+    if (!std::filesystem::exists(filename))
+    {
+        std::cerr << "Error: File does not exist: " << filename << std::endl;
+        return std::nullopt;
+    }
+
+    std::ifstream temp_in(filename);
+    if (!temp_in.is_open())
+    {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return std::nullopt;
+    }
+
+    std::vector<float> T;
+    std::string line;
+    while (std::getline(temp_in, line))
+    {
+        std::stringstream ss(line);
+        std::string temp_str;
+        while (std::getline(ss, temp_str, ','))
+        {
+            try
+            {
+                T.push_back(std::stof(temp_str));
+            }
+            catch (const std::invalid_argument& e)
+            {
+                std::cerr << "Invalid data in file: " << filename << std::endl;
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (T.empty())
+    {
+        std::cerr << "Error: No temperature data found in file: " << filename << std::endl;
+        return std::nullopt;
+    }
+
+    return T;
+}
+
+/**
+ * Reads a temperature profile from a CSV file through a read-only memory mapping.
+ *
+ * Drop-in alternative to read_temperature_profile: the output is pre-sized by counting
+ * separators and values are parsed in place with std::from_chars, so no per-line or
+ * per-token heap allocation takes place. Malformed values are reported by byte offset.
+ *
+ * @param filename The name of the file to read the temperature profile from.
+ * @return A vector of floats representing the temperature profile read from the file, or nullopt on failure.
+ */
+inline std::optional<std::vector<float>> read_temperature_profile_mapped(const std::string& filename)
+{
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return std::nullopt;
+    }
+
+    const char* data = file.data();
+    std::vector<float> T;
+    if (file.size() > 0)
+    {
+        T.reserve(count_csv_values(data, data + file.size()));
+
+        std::size_t error_offset = 0;
+        if (!parse_temperature_csv(data, 0, file.size(), T, error_offset))
+        {
+            std::cerr << "Invalid data in file: " << filename << " at byte offset " << error_offset << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    if (T.empty())
+    {
+        std::cerr << "Error: No temperature data found in file: " << filename << std::endl;
+        return std::nullopt;
+    }
+
+    return T;
+}
+
+/**
+ * Writes the normalized temperature profile to a file.
+ *
+ * @param filename The name of the file to write the normalized temperature profile to.
+ * @param T The vector of normalized temperature values.
+ * @param fast_writer Format with BufferedTextWriter (shortest round-trip, flushed per buffer)
+ *                    instead of std::ofstream with std::endl after every value.
+ */
+inline void write_normalized_temperature_profile(const std::string& filename, const std::vector<float>& T, bool fast_writer = true)
+{
+    if (fast_writer)
+    {
+        BufferedTextWriter outfile(filename);
+        if (!outfile.is_open())
+        {
+            std::cerr << "Error opening file for writing: " << filename << std::endl;
+            return;
+        }
+
+        for (const auto& temp : T)
+        {
+            outfile << temp << '\n';
+        }
+
+        outfile.close();
+        if (outfile.fail())
+        {
+            std::cerr << "Error writing to file: " << filename << std::endl;
+        }
+        return;
+    }
+
+    std::ofstream outfile(filename);
+    if (!outfile.is_open())
+    {
+        std::cerr << "Error opening file for writing: " << filename << std::endl;
+        return;
+    }
+
+    for (const auto& temp : T)
+    {
+        outfile << temp << std::endl;
+    }
+
+    if (outfile.fail())
+    {
+        std::cerr << "Error writing to file: " << filename << std::endl;
+    }
+}
+
+/**
+ * Returns the offset of the first byte after the next comma or newline at or after pos,
+ * so that a chunk starting there begins on a value boundary.
+ *
+ * @param data Pointer to the file contents.
+ * @param size Size of the file contents in bytes.
+ * @param pos The tentative chunk boundary.
+ * @return The aligned chunk boundary, or size if no separator follows pos.
+ */
+inline std::size_t align_to_csv_boundary(const char* data, std::size_t size, std::size_t pos)
+{
+    while (pos < size && data[pos] != ',' && data[pos] != '\n')
+    {
+        ++pos;
+    }
+    return pos < size ? pos + 1 : size;
+}
+
+/**
+ * Reads a temperature profile from a CSV file with several threads.
+ *
+ * The mapped file is split into byte ranges whose boundaries are moved forward to the
+ * next comma or newline. Each thread parses its range into its own buffer, then the
+ * buffers are copied into the result in range order, so values stay in file order.
+ *
+ * @param filename The name of the file to read the temperature profile from.
+ * @param num_threads The number of threads to use; 0 selects std::thread::hardware_concurrency().
+ * @return A vector of floats representing the temperature profile read from the file, or nullopt on failure.
+ */
+inline std::optional<std::vector<float>> read_temperature_profile_parallel(const std::string& filename, int num_threads)
+{
+    // Below this many bytes per chunk the thread start-up costs more than the parsing
+    constexpr std::size_t min_chunk_bytes = 1 << 16;
+
+    MappedFile file;
+    if (!file.open(filename))
+    {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return std::nullopt;
+    }
+
+    const char* data = file.data();
+    const std::size_t size = file.size();
+
+    std::size_t chunks = num_threads > 0 ? static_cast<std::size_t>(num_threads)
+                                         : std::max(1u, std::thread::hardware_concurrency());
+    chunks = std::max<std::size_t>(1, std::min(chunks, size / min_chunk_bytes));
+
+    std::vector<std::size_t> bounds(chunks + 1, size);
+    bounds[0] = 0;
+    for (std::size_t c = 1; c < chunks; ++c)
+    {
+        bounds[c] = align_to_csv_boundary(data, size, std::max(bounds[c - 1], size / chunks * c));
+    }
+
+    std::vector<std::vector<float>> parts(chunks);
+    std::vector<std::size_t> error_offsets(chunks, size);
+    std::vector<char> ok(chunks, 1);
+
+    auto parse_chunk = [&](std::size_t c) {
+        parts[c].reserve(count_csv_values(data + bounds[c], data + bounds[c + 1]));
+        ok[c] = parse_temperature_csv(data, bounds[c], bounds[c + 1], parts[c], error_offsets[c]);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks - 1);
+    for (std::size_t c = 1; c < chunks; ++c)
+    {
+        threads.emplace_back(parse_chunk, c);
+    }
+    parse_chunk(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (std::size_t c = 0; c < chunks; ++c)
+    {
+        if (!ok[c])
+        {
+            std::cerr << "Invalid data in file: " << filename << " at byte offset " << error_offsets[c] << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    std::vector<std::size_t> offsets(chunks + 1, 0);
+    for (std::size_t c = 0; c < chunks; ++c)
+    {
+        offsets[c + 1] = offsets[c] + parts[c].size();
+    }
+    if (offsets[chunks] == 0)
+    {
+        std::cerr << "Error: No temperature data found in file: " << filename << std::endl;
+        return std::nullopt;
+    }
+    if (chunks == 1)
+    {
+        return std::move(parts[0]);
+    }
+
+    // Concatenate in parallel as well, each thread copying its own part into place
+    std::vector<float> T(offsets[chunks]);
+    threads.clear();
+    for (std::size_t c = 1; c < chunks; ++c)
+    {
+        threads.emplace_back([&, c] { std::copy(parts[c].begin(), parts[c].end(), T.begin() + offsets[c]); });
+    }
+    std::copy(parts[0].begin(), parts[0].end(), T.begin());
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    return T;
+}
+
+#endif // TEMPERATURE_IO_H
@@ -0,0 +1,242 @@
+#ifndef TEMPERATURE_STREAM_H
+#define TEMPERATURE_STREAM_H
+
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include "temperature_io.h"
+#include "normalize_kernels.h"
+#include "temperature_binary.h"
+#include "../../common/buffered_text_writer.h"
+
+/**
+ * Reads a CSV temperature file block by block and hands the parsed values of each block to a callback.
+ *
+ * At most block_bytes of the file are buffered at a time. A block ends at its last comma or
+ * newline; the partial value after it is carried over to the next block, so no value is split.
+ *
+ * @param filename The name of the file to read.
+ * @param block_bytes The number of bytes read from the file per block.
+ * @param process Called with a pointer to the values of each block and their count.
+ * @return true on success, false if the file cannot be read or contains a malformed value.
+ */
+inline bool for_each_temperature_block(const std::string& filename, std::size_t block_bytes,
+                                       const std::function<void(float*, std::size_t)>& process)
+{
+    std::ifstream infile(filename, std::ios::binary);
+    if (!infile.is_open())
+    {
+        std::cerr << "Error opening file: " << filename << std::endl;
+        return false;
+    }
+
+    std::vector<char> buffer(block_bytes);
+    std::vector<float> values;
+    values.reserve(block_bytes / 2 + 1);
+
+    std::size_t carry = 0;       // bytes of an incomplete value kept from the previous block
+    std::size_t file_offset = 0; // file offset of buffer[0], used to report malformed values
+    bool eof = false;
+    while (!eof)
+    {
+        if (carry == buffer.size())
+        {
+            // A single value longer than the block; grow just enough to finish it
+            buffer.resize(buffer.size() * 2);
+        }
+        infile.read(buffer.data() + carry, static_cast<std::streamsize>(buffer.size() - carry));
+        std::size_t filled = carry + static_cast<std::size_t>(infile.gcount());
+        eof = !infile;
+
+        std::size_t end = filled;
+        if (!eof)
+        {
+            while (end > 0 && buffer[end - 1] != ',' && buffer[end - 1] != '\n')
+            {
+                --end;
+            }
+        }
+
+        values.clear();
+        std::size_t error_offset = 0;
+        if (!parse_temperature_csv(buffer.data(), 0, end, values, error_offset))
+        {
+            std::cerr << "Invalid data in file: " << filename << " at byte offset " << file_offset + error_offset << std::endl;
+            return false;
+        }
+        if (!values.empty())
+        {
+            process(values.data(), values.size());
+        }
+
+        carry = filled - end;
+        std::copy(buffer.begin() + end, buffer.begin() + filled, buffer.begin());
+        file_offset += end;
+    }
+
+    return true;
+}
+
+/**
+ * Reads a binary temperature profile block by block and hands the values of each block to a callback.
+ *
+ * The profile is memory-mapped; each block of block_bytes is copied into a buffer, so the
+ * callback may modify the values as it does for for_each_temperature_block.
+ *
+ * @param filename The name of the binary temperature profile to read.
+ * @param block_bytes The number of bytes of values handed over per block.
+ * @param process Called with a pointer to the values of each block and their count.
+ * @return true on success, false if the file is not a valid binary temperature profile.
+ */
+inline bool for_each_temperature_binary_block(const std::string& filename, std::size_t block_bytes,
+                                              const std::function<void(float*, std::size_t)>& process)
+{
+    MappedTemperatureProfile profile;
+    if (!profile.open(filename))
+    {
+        return false;
+    }
+
+    const std::size_t per_block = std::max<std::size_t>(block_bytes / sizeof(float), 1);
+    std::vector<float> values(std::min(per_block, profile.size()));
+    for (std::size_t first = 0; first < profile.size(); first += per_block)
+    {
+        const std::size_t n = std::min(per_block, profile.size() - first);
+        std::copy(profile.data() + first, profile.data() + first + n, values.begin());
+        process(values.data(), n);
+    }
+    return true;
+}
+
+/**
+ * Normalizes a temperature file of any size in two passes, holding at most one block in memory.
+ *
+ * The first pass finds the minimum and maximum block by block; the second pass re-reads the
+ * file, normalizes each block in place and writes it through a block-sized output buffer,
+ * either as text through BufferedTextWriter or in the binary format of temperature_binary.h.
+ * The input may be CSV or a binary profile. If the second pass does not see as many values as
+ * the first, because the file changed in between, the output is incomplete and false is returned.
+ *
+ * @param input_filename The name of the CSV or binary file to read the temperature profile from.
+ * @param output_filename The name of the file to write the normalized temperature profile to.
+ * @param Tmin The minimum desired temperature value.
+ * @param Tmax The maximum desired temperature value.
+ * @param block_bytes The number of input bytes processed per block.
+ * @param binary Write the binary format instead of one value per line.
+ * @param count Set to the number of values processed.
+ * @return true on success, false on any read, parse, normalization or write error.
+ */
+inline bool normalize_temperature_file_streaming(const std::string& input_filename, const std::string& output_filename,
+                                                 float Tmin, float Tmax, std::size_t block_bytes, bool binary,
+                                                 std::size_t& count)
+{
+    count = 0;
+    const bool binary_input = is_temperature_binary_file(input_filename);
+    auto for_each_block = [&](const std::function<void(float*, std::size_t)>& process) {
+        return binary_input ? for_each_temperature_binary_block(input_filename, block_bytes, process)
+                            : for_each_temperature_block(input_filename, block_bytes, process);
+    };
+
+    float T_min = 0.0f, T_max = 0.0f;
+    bool ok = for_each_block([&](float* values, std::size_t n) {
+        float lo, hi;
+        find_min_max(values, n, lo, hi);
+        T_min = count == 0 ? lo : std::min(T_min, lo);
+        T_max = count == 0 ? hi : std::max(T_max, hi);
+        count += n;
+    });
+    if (!ok)
+    {
+        return false;
+    }
+
+    if (count == 0)
+    {
+        std::cerr << "Error: No temperature data found in file: " << input_filename << std::endl;
+        return false;
+    }
+    if (T_min == T_max)
+    {
+        std::cerr << "Error: All temperature values are the same. Normalization is not possible." << std::endl;
+        return false;
+    }
+
+    const float scale = (Tmax - Tmin) / (T_max - T_min);
+    const float offset = Tmin - T_min * scale;
+
+    // The second pass must see the values the first pass measured, or the range and the count
+    // in a binary header are wrong
+    std::size_t second_count = 0;
+    auto check_second_count = [&]() {
+        if (second_count != count)
+        {
+            std::cerr << "Error: " << input_filename << " changed during normalization (" << count << " values, then "
+                      << second_count << ")." << std::endl;
+            return false;
+        }
+        return true;
+    };
+
+    if (!binary)
+    {
+        BufferedTextWriter outfile(output_filename, std::ios::out, block_bytes);
+        if (!outfile.is_open())
+        {
+            std::cerr << "Error opening file for writing: " << output_filename << std::endl;
+            return false;
+        }
+
+        ok = for_each_block([&](float* values, std::size_t n) {
+            second_count += n;
+            apply_scale_offset(values, values, n, scale, offset);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                outfile << values[i] << '\n';
+            }
+        });
+
+        outfile.close();
+        if (outfile.fail())
+        {
+            std::cerr << "Error writing to file: " << output_filename << std::endl;
+            return false;
+        }
+        return ok && check_second_count();
+    }
+
+    // The buffer has to be installed before the file is opened to take effect
+    std::vector<char> out_buffer(block_bytes);
+    std::ofstream outfile;
+    outfile.rdbuf()->pubsetbuf(out_buffer.data(), static_cast<std::streamsize>(out_buffer.size()));
+    outfile.open(output_filename, std::ios::out | std::ios::binary);
+    if (!outfile.is_open())
+    {
+        std::cerr << "Error opening file for writing: " << output_filename << std::endl;
+        return false;
+    }
+
+    unsigned char header[temperature_binary_header_size];
+    fill_temperature_binary_header(header, count, Tmin, Tmax);
+    outfile.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    ok = for_each_block([&](float* values, std::size_t n) {
+        second_count += n;
+        apply_scale_offset(values, values, n, scale, offset);
+        write_float32_little_endian(outfile, values, n);
+    });
+
+    outfile.close();
+    if (outfile.fail())
+    {
+        std::cerr << "Error writing to file: " << output_filename << std::endl;
+        return false;
+    }
+
+    return ok && check_second_count();
+}
+
+#endif // TEMPERATURE_STREAM_H
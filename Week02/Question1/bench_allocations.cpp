@@ -0,0 +1,98 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "vector.h"
+#include "particle.h"
+#include "heap_vector.h"
+using namespace std;
+
+// Every heap allocation in this program goes through here and is counted
+static size_t allocationCount = 0;
+
+void *operator new(size_t size)
+{
+    ++allocationCount;
+    if (void *p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    free(p);
+}
+
+// Particle::update as it was written against HeapVector
+struct HeapParticle
+{
+    double mass;
+    HeapVector position, velocity, force;
+
+    void update(double dt)
+    {
+        HeapVector acceleration = force * (1.0 / mass);
+        velocity = velocity + acceleration * dt;
+        position = position + velocity * dt;
+    }
+};
+
+// Runs updates on a particle and reports allocations and time per update
+template <typename Update>
+void measure(const char *name, size_t dimension, Update update, int updates, ofstream &csvFile)
+{
+    size_t before = allocationCount;
+    auto start = chrono::high_resolution_clock::now();
+    for (int i = 0; i < updates; ++i) {
+        update();
+    }
+    auto end = chrono::high_resolution_clock::now();
+    double seconds = chrono::duration<double>(end - start).count();
+    double allocationsPerUpdate = static_cast<double>(allocationCount - before) / updates;
+
+    cout << name << " " << dimension << "D: " << allocationsPerUpdate << " allocations/update, "
+         << 1e9 * seconds / updates << " ns/update" << endl;
+    csvFile << name << "," << dimension << "," << updates << "," << allocationsPerUpdate << "," << 1e9 * seconds / updates << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    int updates = argc > 1 ? atoi(argv[1]) : 10000000;
+    if (updates <= 0) {
+        cerr << "Usage: " << argv[0] << " [updates]" << endl;
+        return 1;
+    }
+    const double dt = 1e-3;
+
+    ofstream csvFile("allocation_benchmark_results.csv");
+    csvFile << "vector,dimension,updates,allocations_per_update,ns_per_update\n";
+
+    HeapParticle heap2{1.0, HeapVector({0., 0.}), HeapVector({1., 2.}), HeapVector({0.5, -0.5})};
+    HeapParticle heap3{1.0, HeapVector({0., 0., 0.}), HeapVector({1., 2., 3.}), HeapVector({0.5, -0.5, 0.25})};
+    Particle particle2(1.0, Vector(0., 0.), Vector(1., 2.), Vector(0.5, -0.5));
+    Particle particle3(1.0, Vector(0., 0., 0.), Vector(1., 2., 3.), Vector(0.5, -0.5, 0.25));
+
+    measure("heap", 2, [&] { heap2.update(dt); }, updates, csvFile);
+    measure("heap", 3, [&] { heap3.update(dt); }, updates, csvFile);
+    measure("array", 2, [&] { particle2.update(0.0, dt); }, updates, csvFile);
+    measure("array", 3, [&] { particle3.update(0.0, dt); }, updates, csvFile);
+
+    // Both representations must follow the same trajectory
+    for (size_t i = 0; i < 3; ++i) {
+        if (heap3.position[i] != particle3.getPosition()[i]) {
+            cerr << "Trajectories differ in component " << i << endl;
+            return 1;
+        }
+    }
+
+    cout << "Results saved to allocation_benchmark_results.csv" << endl;
+    return 0;
+}
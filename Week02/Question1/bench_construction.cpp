@@ -0,0 +1,96 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "vector.h"
+#include "particle.h"
+#include "particle_batch.h"
+using namespace std;
+
+// Particle as it was before its lifecycle trace became opt-in
+struct TracedParticle
+{
+    double mass;
+    Vec3 position, velocity, force;
+
+    TracedParticle(double mass, const Vec3 &position, const Vec3 &velocity, const Vec3 &force)
+        : mass(mass), position(position), velocity(velocity), force(force)
+    {
+        cout << "Particle created at position " << position << endl;
+    }
+
+    TracedParticle(const TracedParticle &) = default;
+
+    ~TracedParticle()
+    {
+        cout << "Particle destroyed at position " << position << endl;
+    }
+};
+
+// Time to construct and then destroy count 3D particles from contiguous input arrays, with the
+// old per-particle trace (sent to a log file, as a redirected run would) and with makeParticles
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    if (count == 0) {
+        cerr << "Usage: " << argv[0] << " [particles]" << endl;
+        return 1;
+    }
+
+    vector<double> mass(count);
+    vector<Vec3> position(count), velocity(count), force(count);
+    for (size_t i = 0; i < count; ++i) {
+        double x = static_cast<double>(i % 1000) / 1000.0;
+        mass[i] = 1.0 + x;
+        position[i] = Vector(x, 1.0 - x, 0.0);
+        velocity[i] = Vector(1.0, x, -x);
+        force[i] = Vector(0.5 * x, -1.0, 0.25);
+    }
+
+    double tracedConstruct, tracedDestroy;
+    {
+        ofstream log("particle_lifecycle.log");
+        streambuf *coutBuffer = cout.rdbuf(log.rdbuf());
+
+        auto start = chrono::high_resolution_clock::now();
+        auto *particles = new vector<TracedParticle>();
+        particles->reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            particles->emplace_back(mass[i], position[i], velocity[i], force[i]);
+        }
+        auto built = chrono::high_resolution_clock::now();
+        delete particles;
+        auto end = chrono::high_resolution_clock::now();
+
+        cout.rdbuf(coutBuffer);
+        tracedConstruct = chrono::duration<double>(built - start).count();
+        tracedDestroy = chrono::duration<double>(end - built).count();
+    }
+    remove("particle_lifecycle.log");
+
+    auto start = chrono::high_resolution_clock::now();
+    auto *particles = new vector<Particle<3>>(makeParticles(mass.data(), position.data(), velocity.data(), force.data(), count));
+    auto built = chrono::high_resolution_clock::now();
+    const double check = (*particles)[count - 1].getPosition()[0];
+    delete particles;
+    auto end = chrono::high_resolution_clock::now();
+    const double silentConstruct = chrono::duration<double>(built - start).count();
+    const double silentDestroy = chrono::duration<double>(end - built).count();
+    if (check != position[count - 1][0]) {
+        cerr << "makeParticles lost the input" << endl;
+        return 1;
+    }
+
+    cout << "Traced:        construct " << tracedConstruct << " s, destroy " << tracedDestroy << " s" << endl;
+    cout << "makeParticles: construct " << silentConstruct << " s (" << tracedConstruct / silentConstruct
+         << "x), destroy " << silentDestroy << " s" << endl;
+
+    ofstream csvFile("construction_benchmark_results.csv");
+    csvFile << "method,particles,construct_seconds,destroy_seconds\n";
+    csvFile << "traced," << count << "," << tracedConstruct << "," << tracedDestroy << "\n";
+    csvFile << "make_particles," << count << "," << silentConstruct << "," << silentDestroy << "\n";
+    cout << "Results saved to construction_benchmark_results.csv" << endl;
+    return 0;
+}
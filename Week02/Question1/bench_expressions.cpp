@@ -0,0 +1,131 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "vector.h"
+#include "heap_vector.h"
+using namespace std;
+
+// Runs kernel over all particles several times and returns the best time per particle in ns
+template <typename Kernel>
+double time_per_particle(Kernel kernel, size_t particles, int repeats)
+{
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        kernel();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count());
+    }
+    return 1e9 * best / particles;
+}
+
+// Evaluates a long chain of vector arithmetic over large particle arrays:
+//   r = 2 a + 3 b - 0.5 c + dt d      (vector result)
+//   s = (2 a + 3 b) * (a + b)         (dot product of two expressions)
+// with the heap-backed baseline, with every intermediate stored in a named Vec3, and with
+// expression templates, which evaluate each chain in one loop over the components.
+int main(int argc, char *argv[])
+{
+    size_t particles = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    int repeats = argc > 2 ? atoi(argv[2]) : 5;
+    if (particles == 0 || repeats <= 0) {
+        cerr << "Usage: " << argv[0] << " [particles] [repeats]" << endl;
+        return 1;
+    }
+    const double dt = 1e-3;
+
+    vector<Vec3> a, b, c, d, r(particles);
+    vector<HeapVector> ha, hb, hc, hd;
+    for (size_t i = 0; i < particles; ++i) {
+        double x = static_cast<double>(i % 1000) / 1000.0;
+        a.emplace_back(x, 1.0 - x, 0.5 * x);
+        b.emplace_back(2.0 * x, x, 1.0);
+        c.emplace_back(-x, 0.25, x * x);
+        d.emplace_back(1.0, -x, 2.0 * x);
+        ha.emplace_back(vector<double>{a[i][0], a[i][1], a[i][2]});
+        hb.emplace_back(vector<double>{b[i][0], b[i][1], b[i][2]});
+        hc.emplace_back(vector<double>{c[i][0], c[i][1], c[i][2]});
+        hd.emplace_back(vector<double>{d[i][0], d[i][1], d[i][2]});
+    }
+
+    ofstream csvFile("expression_benchmark_results.csv");
+    csvFile << "chain,method,particles,ns_per_particle,checksum\n";
+
+    double checksum = 0.0;
+    auto report = [&](const char *chain, const char *method, double ns) {
+        cout << chain << " (" << method << "): " << ns << " ns/particle, checksum " << checksum << endl;
+        csvFile << chain << "," << method << "," << particles << "," << ns << "," << checksum << "\n";
+    };
+
+    // Vector chain
+    double ns = time_per_particle([&] {
+        checksum = 0.0;
+        for (size_t i = 0; i < particles; ++i) {
+            HeapVector h = 2. * ha[i] + 3. * hb[i] - 0.5 * hc[i] + hd[i] * dt;
+            checksum += h[0] + h[1] + h[2];
+        }
+    }, particles, repeats);
+    report("axpy_chain", "heap", ns);
+
+    ns = time_per_particle([&] {
+        for (size_t i = 0; i < particles; ++i) {
+            Vec3 t1 = 2. * a[i];
+            Vec3 t2 = 3. * b[i];
+            Vec3 t3 = 0.5 * c[i];
+            Vec3 t4 = d[i] * dt;
+            Vec3 t5 = t1 + t2;
+            Vec3 t6 = t5 - t3;
+            r[i] = t6 + t4;
+        }
+    }, particles, repeats);
+    checksum = 0.0;
+    for (const auto &v : r) {
+        checksum += v[0] + v[1] + v[2];
+    }
+    report("axpy_chain", "temporaries", ns);
+
+    ns = time_per_particle([&] {
+        for (size_t i = 0; i < particles; ++i) {
+            r[i] = 2. * a[i] + 3. * b[i] - 0.5 * c[i] + d[i] * dt;
+        }
+    }, particles, repeats);
+    checksum = 0.0;
+    for (const auto &v : r) {
+        checksum += v[0] + v[1] + v[2];
+    }
+    report("axpy_chain", "expression", ns);
+
+    // Dot product of two expressions
+    ns = time_per_particle([&] {
+        checksum = 0.0;
+        for (size_t i = 0; i < particles; ++i) {
+            checksum += (2. * ha[i] + 3. * hb[i]) * (ha[i] + hb[i]);
+        }
+    }, particles, repeats);
+    report("dot_chain", "heap", ns);
+
+    ns = time_per_particle([&] {
+        checksum = 0.0;
+        for (size_t i = 0; i < particles; ++i) {
+            Vec3 t1 = 2. * a[i];
+            Vec3 t2 = 3. * b[i];
+            Vec3 t3 = t1 + t2;
+            Vec3 t4 = a[i] + b[i];
+            checksum += t3 * t4;
+        }
+    }, particles, repeats);
+    report("dot_chain", "temporaries", ns);
+
+    ns = time_per_particle([&] {
+        checksum = 0.0;
+        for (size_t i = 0; i < particles; ++i) {
+            checksum += (2. * a[i] + 3. * b[i]) * (a[i] + b[i]);
+        }
+    }, particles, repeats);
+    report("dot_chain", "expression", ns);
+
+    cout << "Results saved to expression_benchmark_results.csv" << endl;
+    return 0;
+}
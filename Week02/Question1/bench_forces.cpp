@@ -0,0 +1,102 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include "vector.h"
+#include "particle_system.h"
+#include "forces.h"
+using namespace std;
+
+// Returns the wall-clock time of one computeForces call, in seconds
+template <size_t N>
+double time_forces(ForceModel<N> &model, ParticleSystem<N> &system)
+{
+    auto start = chrono::high_resolution_clock::now();
+    model.computeForces(system);
+    auto end = chrono::high_resolution_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+// RMS of the force error relative to the RMS reference force
+template <size_t N>
+double relative_error(const ParticleSystem<N> &system, const array<vector<double>, N> &reference)
+{
+    double error = 0.0, norm2 = 0.0;
+    for (size_t d = 0; d < N; ++d) {
+        for (size_t i = 0; i < system.size(); ++i) {
+            double e = system.force(d)[i] - reference[d][i];
+            error += e * e;
+            norm2 += reference[d][i] * reference[d][i];
+        }
+    }
+    return norm2 > 0.0 ? sqrt(error / norm2) : sqrt(error);
+}
+
+template <size_t N>
+array<vector<double>, N> copy_forces(const ParticleSystem<N> &system)
+{
+    array<vector<double>, N> forces;
+    for (size_t d = 0; d < N; ++d) {
+        forces[d].assign(system.force(d), system.force(d) + system.size());
+    }
+    return forces;
+}
+
+// Accuracy and speed of the cell list (short-range repulsion) and of Barnes-Hut (gravity)
+// against the direct O(N^2) sum, for particles spread uniformly over the unit cube
+int main(int argc, char *argv[])
+{
+    size_t maxCount = argc > 1 ? strtoul(argv[1], nullptr, 10) : 16000;
+    if (maxCount == 0) {
+        cerr << "Usage: " << argv[0] << " [max particles]" << endl;
+        return 1;
+    }
+
+    ofstream csvFile("force_benchmark_results.csv");
+    csvFile << "method,particles,parameter,seconds,speedup,relative_error\n";
+
+    for (size_t count = 1000; count <= maxCount; count *= 4) {
+        mt19937_64 rng(42);
+        uniform_real_distribution<double> uniform(0.0, 1.0);
+        ParticleSystem<3> system;
+        system.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            system.add(0.5 + uniform(rng), Vector(uniform(rng), uniform(rng), uniform(rng)), Vector(0.0, 0.0, 0.0), Vector(0.0, 0.0, 0.0));
+        }
+
+        // Short range: about 30 neighbours within the cutoff
+        SoftRepulsion repulsion;
+        repulsion.cutoff = cbrt(30.0 / (4.18879 * count));
+        DirectForce<3, SoftRepulsion> directRepulsion(repulsion);
+        double directTime = time_forces(directRepulsion, system);
+        auto reference = copy_forces(system);
+        csvFile << "direct_repulsion," << count << ",0," << directTime << ",1,0\n";
+
+        CellListForce<3, SoftRepulsion> cells(repulsion);
+        double time = time_forces(cells, system);
+        double error = relative_error(system, reference);
+        cout << count << " particles, cell list: " << time << " s (" << directTime / time << "x), error " << error << endl;
+        csvFile << "cell_list," << count << "," << repulsion.cutoff << "," << time << "," << directTime / time << "," << error << "\n";
+
+        // Long range
+        DirectForce<3, Gravity> directGravity;
+        directTime = time_forces(directGravity, system);
+        reference = copy_forces(system);
+        csvFile << "direct_gravity," << count << ",0," << directTime << ",1,0\n";
+
+        for (double theta : {0.3, 0.5, 0.8}) {
+            BarnesHutForce<3> tree(Gravity(), theta);
+            time = time_forces(tree, system);
+            error = relative_error(system, reference);
+            cout << count << " particles, Barnes-Hut theta " << theta << ": " << time << " s ("
+                 << directTime / time << "x), error " << error << endl;
+            csvFile << "barnes_hut," << count << "," << theta << "," << time << "," << directTime / time << "," << error << "\n";
+        }
+    }
+
+    cout << "Results saved to force_benchmark_results.csv" << endl;
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include "vector.h"
+#include "particle_system.h"
+#include "forces.h"
+#include "integrators.h"
+using namespace std;
+
+const double pi = 3.14159265358979323846;
+
+// Particles spread over the unit cube with small random-looking velocities
+ParticleSystem<3> make_system(size_t count)
+{
+    ParticleSystem<3> system(count);
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t d = 0; d < 3; ++d) {
+            system.position(d)[i] = fmod(0.618034 * (i + 1) * (d + 1), 1.0) - 0.5;
+            system.velocity(d)[i] = 0.1 * sin(3.0 * i + d);
+        }
+        system.setMass(i, 1.0 + 0.5 * cos(double(i)));
+    }
+    return system;
+}
+
+struct Run
+{
+    double drift;   // largest relative energy error seen
+    double seconds; // wall-clock time of the whole run
+};
+
+// Integrates the harmonic trap up to simulated time endTime and checks the energy every period
+Run run(Integrator<3> &integrator, ParticleSystem<3> system, double dt, double endTime)
+{
+    HarmonicTrap<3> trap;
+    const double initial = kineticEnergy(system) + trap.potentialEnergy(system);
+    const int steps = static_cast<int>(endTime / dt + 0.5);
+    const int stepsPerCheck = max(1, static_cast<int>(2.0 * pi / dt));
+    Run result{0.0, 0.0};
+    for (int s = 1; s <= steps; ++s) {
+        auto start = chrono::high_resolution_clock::now();
+        integrator.step(system, trap, dt);
+        auto end = chrono::high_resolution_clock::now();
+        result.seconds += chrono::duration<double>(end - start).count();
+        if (s % stepsPerCheck == 0 || s == steps) {
+            integrator.synchronize(system, trap);
+            double energy = kineticEnergy(system) + trap.potentialEnergy(system);
+            result.drift = max(result.drift, fabs(energy - initial) / initial);
+        }
+    }
+    return result;
+}
+
+// Energy drift and wall-clock time of the Euler, Velocity Verlet and leapfrog integrators over
+// a range of time steps, and the cheapest run of each that stays within the drift budget
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    double budget = argc > 2 ? atof(argv[2]) : 1e-3;
+    if (count == 0 || budget <= 0.0) {
+        cerr << "Usage: " << argv[0] << " [particles] [relative energy drift budget]" << endl;
+        return 1;
+    }
+    const double endTime = 20.0 * pi; // ten periods of the trap
+    const ParticleSystem<3> initial = make_system(count);
+
+    struct Method
+    {
+        const char *name;
+        unique_ptr<Integrator<3>> (*make)();
+    };
+    const Method methods[] = {
+        {"euler", [] { return unique_ptr<Integrator<3>>(new EulerIntegrator<3>()); }},
+        {"velocity_verlet", [] { return unique_ptr<Integrator<3>>(new VelocityVerlet<3>()); }},
+        {"leapfrog", [] { return unique_ptr<Integrator<3>>(new Leapfrog<3>()); }},
+    };
+    const double timeSteps[] = {0.2, 0.1, 0.05, 0.02, 0.01, 0.005, 0.002, 0.001};
+
+    ofstream csvFile("integrator_benchmark_results.csv");
+    csvFile << "integrator,particles,dt,relative_energy_drift,seconds\n";
+
+    for (const Method &method : methods) {
+        double bestSeconds = 0.0, bestDt = 0.0;
+        for (double dt : timeSteps) {
+            unique_ptr<Integrator<3>> integrator = method.make();
+            Run result = run(*integrator, initial, dt, endTime);
+            csvFile << method.name << "," << count << "," << dt << "," << result.drift << "," << result.seconds << "\n";
+            if (result.drift <= budget && bestDt == 0.0) {
+                bestDt = dt;
+                bestSeconds = result.seconds;
+            }
+        }
+        if (bestDt > 0.0) {
+            cout << method.name << ": drift <= " << budget << " from dt = " << bestDt << ", " << bestSeconds
+                 << " s for ten periods" << endl;
+        } else {
+            cout << method.name << ": drift above " << budget << " for every time step tried" << endl;
+        }
+    }
+    cout << "Results saved to integrator_benchmark_results.csv" << endl;
+    return 0;
+}
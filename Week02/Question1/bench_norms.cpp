@@ -0,0 +1,92 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include "vector.h"
+#include "particle_system.h"
+using namespace std;
+
+// Returns the best wall-clock time of repeats calls to run, in seconds per call
+template <typename Run>
+double best_time(Run run, int repeats)
+{
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = chrono::high_resolution_clock::now();
+        run();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+// Speeds of many 3D particles: the string-dispatched norm per vector against norm<L2Norm>,
+// the batched version over an array of vectors, and the batched version over the velocity
+// arrays of a ParticleSystem
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    int repeats = argc > 2 ? atoi(argv[2]) : 10;
+    if (count == 0 || repeats <= 0) {
+        cerr << "Usage: " << argv[0] << " [particles] [repeats]" << endl;
+        return 1;
+    }
+
+    vector<Vec3> velocities(count);
+    ParticleSystem<3> system(count);
+    for (size_t i = 0; i < count; ++i) {
+        double x = static_cast<double>(i % 1000) / 1000.0;
+        velocities[i] = Vector(1.0, x, -x);
+        system[i].setVelocity(velocities[i]);
+    }
+    vector<double> speed(count), reference(count);
+    const string type = "L2";
+
+    double stringTime = best_time([&] {
+        for (size_t i = 0; i < count; ++i) {
+            reference[i] = norm(velocities[i], type);
+        }
+    }, repeats);
+    double tagTime = best_time([&] {
+        for (size_t i = 0; i < count; ++i) {
+            speed[i] = norm<L2Norm>(velocities[i]);
+        }
+    }, repeats);
+    double batchedTime = best_time([&] { norms<L2Norm>(velocities.data(), count, speed.data()); }, repeats);
+    double systemTime = best_time([&] { system.speeds<L2Norm>(speed.data()); }, repeats);
+    double squaredTime = best_time([&] { system.speeds<SquaredL2Norm>(speed.data()); }, repeats);
+
+    system.speeds<L2Norm>(speed.data());
+    for (size_t i = 0; i < count; ++i) {
+        if (speed[i] != reference[i]) {
+            cerr << "Batched and single norms disagree at particle " << i << endl;
+            return 1;
+        }
+    }
+
+    const struct
+    {
+        const char *name;
+        const char *key;
+        double seconds;
+    } results[] = {
+        {"norm(v, \"L2\")", "string_dispatch", stringTime},
+        {"norm<L2Norm>(v)", "compile_time", tagTime},
+        {"norms<L2Norm>(Vector[])", "batched_vectors", batchedTime},
+        {"ParticleSystem::speeds<L2Norm>", "batched_particle_system", systemTime},
+        {"ParticleSystem::speeds<SquaredL2Norm>", "batched_particle_system_squared", squaredTime},
+    };
+
+    ofstream csvFile("norm_benchmark_results.csv");
+    csvFile << "method,particles,seconds,ns_per_particle\n";
+    for (const auto &result : results) {
+        cout << result.name << ": " << 1e9 * result.seconds / count << " ns/particle (" << stringTime / result.seconds
+             << "x)" << endl;
+        csvFile << result.key << "," << count << "," << result.seconds << "," << 1e9 * result.seconds / count << "\n";
+    }
+    cout << "Results saved to norm_benchmark_results.csv" << endl;
+    return 0;
+}
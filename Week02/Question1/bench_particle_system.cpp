@@ -0,0 +1,76 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "vector.h"
+#include "particle.h"
+#include "particle_system.h"
+using namespace std;
+
+// Returns the best wall-clock time of steps calls to step, in seconds per step
+template <typename Step>
+double time_per_step(Step step, int steps)
+{
+    double best = 1e300;
+    for (int s = 0; s < steps; ++s) {
+        auto start = chrono::high_resolution_clock::now();
+        step();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+// Compares one explicit Euler step over many 3D particles stored as an array of Particle
+// objects with the same step on a ParticleSystem (structure of arrays)
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    int steps = argc > 2 ? atoi(argv[2]) : 10;
+    if (count == 0 || steps <= 0) {
+        cerr << "Usage: " << argv[0] << " [particles] [steps]" << endl;
+        return 1;
+    }
+    const double dt = 1e-3;
+
+    ParticleSystem<3> system;
+    system.reserve(count);
+    vector<Particle<3>> particles;
+    particles.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        double x = static_cast<double>(i % 1000) / 1000.0;
+        Vector position(x, 1.0 - x, 0.0);
+        Vector velocity(1.0, x, -x);
+        Vector force(0.5 * x, -1.0, 0.25);
+        double mass = 1.0 + x;
+        system.add(mass, position, velocity, force);
+        particles.emplace_back(mass, position, velocity, force);
+    }
+
+    double aosTime = time_per_step([&] {
+        for (auto &p : particles) {
+            p.update(0.0, dt);
+        }
+    }, steps);
+    double soaTime = time_per_step([&] { system.update(0.0, dt); }, steps);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (system[i].getPosition()[1] != particles[i].getPosition()[1]) {
+            cerr << "ParticleSystem and Particle disagree at particle " << i << endl;
+            return 1;
+        }
+    }
+
+    cout << "Particle objects: " << 1e9 * aosTime / count << " ns/particle" << endl;
+    cout << "ParticleSystem:   " << 1e9 * soaTime / count << " ns/particle (" << aosTime / soaTime << "x)" << endl;
+
+    ofstream csvFile("particle_system_benchmark_results.csv");
+    csvFile << "layout,particles,seconds_per_step,ns_per_particle\n";
+    csvFile << "particle_objects," << count << "," << aosTime << "," << 1e9 * aosTime / count << "\n";
+    csvFile << "particle_system," << count << "," << soaTime << "," << 1e9 * soaTime / count << "\n";
+    cout << "Results saved to particle_system_benchmark_results.csv" << endl;
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "vector.h"
+#include "particle.h"
+#include "particle_batch.h"
+using namespace std;
+
+// Returns the best wall-clock time of steps calls to step, in seconds per step
+template <typename Step>
+double time_per_step(Step step, int steps)
+{
+    double best = 1e300;
+    for (int s = 0; s < steps; ++s) {
+        auto start = chrono::high_resolution_clock::now();
+        step();
+        auto end = chrono::high_resolution_clock::now();
+        best = min(best, chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+// Strong scaling of updateParticles: a fixed number of 3D particles stepped by 1 to 32
+// threads of a WorkerPool, for 1e5 particles up to the given maximum (1e8 needs 8 GB)
+int main(int argc, char *argv[])
+{
+    size_t maxCount = argc > 1 ? static_cast<size_t>(atof(argv[1])) : 10000000;
+    int steps = argc > 2 ? atoi(argv[2]) : 5;
+    if (maxCount == 0 || steps <= 0) {
+        cerr << "Usage: " << argv[0] << " [max particles] [steps]" << endl;
+        return 1;
+    }
+    const double dt = 1e-3;
+    const unsigned threadCounts[] = {1, 2, 4, 8, 16, 32};
+
+    ofstream csvFile("particle_scaling_results.csv");
+    csvFile << "particles,threads,seconds_per_step,ns_per_particle,speedup,efficiency\n";
+
+    for (size_t count = 100000; count <= maxCount; count *= 10) {
+        vector<Particle<3>> particles;
+        particles.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            double x = static_cast<double>(i % 1000) / 1000.0;
+            particles.emplace_back(1.0 + x, Vector(x, 1.0 - x, 0.0), Vector(1.0, x, -x), Vector(0.5 * x, -1.0, 0.25));
+        }
+
+        double serialTime = 0.0;
+        for (unsigned threads : threadCounts) {
+            WorkerPool pool(threads); // started once, reused for every step
+            double time = time_per_step([&] { updateParticles(particles, 0.0, dt, pool); }, steps);
+            if (threads == 1) {
+                serialTime = time;
+            }
+            double speedup = serialTime / time;
+            cout << count << " particles, " << threads << " threads: " << 1e9 * time / count
+                 << " ns/particle, speedup " << speedup << endl;
+            csvFile << count << "," << threads << "," << time << "," << 1e9 * time / count << ","
+                    << speedup << "," << speedup / threads << "\n";
+        }
+    }
+
+    cout << "Results saved to particle_scaling_results.csv" << endl;
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "vector.h"
+#include "particle_system.h"
+#include "trajectory.h"
+using namespace std;
+
+// Time per frame of writing the positions of all particles as text, one particle per line
+// ended with endl, against the binary TrajectoryWriter, and of reading them back
+int main(int argc, char *argv[])
+{
+    size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000000;
+    int frames = argc > 2 ? atoi(argv[2]) : 5;
+    if (count == 0 || frames <= 0) {
+        cerr << "Usage: " << argv[0] << " [particles] [frames]" << endl;
+        return 1;
+    }
+    const double dt = 1e-3;
+
+    ParticleSystem<3> system(count);
+    auto initialize = [&] {
+        for (size_t i = 0; i < count; ++i) {
+            double x = static_cast<double>(i % 1000) / 1000.0;
+            system[i].setPosition(Vector(x, 1.0 - x, 0.0));
+            system[i].setVelocity(Vector(1.0, x, -x));
+        }
+    };
+
+    initialize();
+    auto start = chrono::high_resolution_clock::now();
+    {
+        ofstream textFile("bench_trajectory.txt");
+        for (int frame = 0; frame < frames; ++frame) {
+            for (size_t i = 0; i < count; ++i) {
+                textFile << frame * dt << " " << system[i].getPosition()[0] << " " << system[i].getPosition()[1] << " "
+                         << system[i].getPosition()[2] << endl;
+            }
+            system.kickDrift(0.0, dt);
+        }
+    }
+    auto end = chrono::high_resolution_clock::now();
+    double textTime = chrono::duration<double>(end - start).count() / frames;
+
+    initialize();
+    start = chrono::high_resolution_clock::now();
+    double appendTime = 0.0;
+    {
+        TrajectoryWriter<3> writer("bench_trajectory.bin", count);
+        for (int frame = 0; frame < frames; ++frame) {
+            auto appendStart = chrono::high_resolution_clock::now();
+            writer.append(frame * dt, system);
+            auto appendEnd = chrono::high_resolution_clock::now();
+            appendTime += chrono::duration<double>(appendEnd - appendStart).count();
+            system.kickDrift(0.0, dt);
+        }
+        if (!writer.close()) {
+            cerr << "Error writing bench_trajectory.bin" << endl;
+            return 1;
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    double binaryTime = chrono::duration<double>(end - start).count() / frames;
+    appendTime /= frames;
+
+    // Reading every frame back: parsing the text (6 digits) against summing the mapped positions
+    start = chrono::high_resolution_clock::now();
+    double textSum = 0.0;
+    {
+        ifstream textFile("bench_trajectory.txt");
+        double t, x, y, z;
+        while (textFile >> t >> x >> y >> z) {
+            textSum += x;
+        }
+    }
+    end = chrono::high_resolution_clock::now();
+    double textReadTime = chrono::duration<double>(end - start).count() / frames;
+
+    start = chrono::high_resolution_clock::now();
+    double binarySum = 0.0;
+    {
+        MappedTrajectory<3> trajectory;
+        if (!trajectory.open("bench_trajectory.bin")) {
+            return 1;
+        }
+        trajectory.forEachFrame(0, trajectory.frameCount(), [&](size_t, double, auto position) {
+            const double *x = position(0);
+            for (size_t i = 0; i < count; ++i) {
+                binarySum += x[i];
+            }
+        });
+    }
+    end = chrono::high_resolution_clock::now();
+    double binaryReadTime = chrono::duration<double>(end - start).count() / frames;
+
+    if (fabs(textSum - binarySum) > 1e-5 * fabs(binarySum) + 1e-6) {
+        cerr << "Text and binary trajectories disagree" << endl;
+        return 1;
+    }
+
+    cout << "Text with endl:    " << textTime << " s/frame, read " << textReadTime << " s/frame" << endl;
+    cout << "TrajectoryWriter:  " << binaryTime << " s/frame (" << textTime / binaryTime << "x), append "
+         << appendTime << " s/frame, read " << binaryReadTime << " s/frame (" << textReadTime / binaryReadTime << "x)" << endl;
+
+    ofstream csvFile("trajectory_benchmark_results.csv");
+    csvFile << "format,particles,frames,write_seconds_per_frame,read_seconds_per_frame\n";
+    csvFile << "text_endl," << count << "," << frames << "," << textTime << "," << textReadTime << "\n";
+    csvFile << "binary," << count << "," << frames << "," << binaryTime << "," << binaryReadTime << "\n";
+    cout << "Results saved to trajectory_benchmark_results.csv" << endl;
+
+    remove("bench_trajectory.txt");
+    remove("bench_trajectory.bin");
+    return 0;
+}
@@ -0,0 +1,558 @@
+#ifndef FORCES_H
+#define FORCES_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "vector.h"
+#include "particle_system.h"
+
+// Pairwise interactions. Each returns the factor s such that the force on particle i from
+// particle j is s * (x_j - x_i), given r2 = |x_j - x_i|^2 and the two masses.
+
+// Newtonian gravity, softened so that close encounters stay finite
+struct Gravity
+{
+    double G = 1.0;
+    double softening = 1e-3;
+
+    double operator()(double r2, double mi, double mj) const
+    {
+        const double s2 = r2 + softening * softening;
+        return G * mi * mj / (s2 * std::sqrt(s2));
+    }
+};
+
+// Short-range soft-sphere repulsion: strength * (1 - r / cutoff) pushing the particles apart,
+// and nothing beyond the cutoff
+struct SoftRepulsion
+{
+    double strength = 1.0;
+    double cutoff = 0.1;
+
+    double operator()(double r2, double mi, double mj) const
+    {
+        (void)mi;
+        (void)mj;
+        if (r2 >= cutoff * cutoff || r2 == 0.0) {
+            return 0.0;
+        }
+        const double r = std::sqrt(r2);
+        return -strength * (1.0 - r / cutoff) / r;
+    }
+};
+
+// Pluggable force computation: sets the force on every particle of the system from the
+// current positions and masses, overwriting the previous forces
+template <std::size_t N>
+class ForceModel
+{
+public:
+    virtual ~ForceModel() = default;
+    virtual void computeForces(ParticleSystem<N> &system) = 0;
+};
+
+// Smallest box containing all particles
+template <std::size_t N>
+void boundingBox(const ParticleSystem<N> &system, Vector<N> &lo, Vector<N> &hi)
+{
+    for (std::size_t d = 0; d < N; ++d) {
+        const double *x = system.position(d);
+        auto range = std::minmax_element(x, x + system.size());
+        lo[d] = *range.first;
+        hi[d] = *range.second;
+    }
+}
+
+// External harmonic trap pulling every particle towards the origin, F = -k m x. Its
+// potential energy is k m |x|^2 / 2.
+template <std::size_t N>
+class HarmonicTrap : public ForceModel<N>
+{
+public:
+    explicit HarmonicTrap(double stiffness = 1.0) : stiffness_(stiffness) {}
+
+    void computeForces(ParticleSystem<N> &system) override
+    {
+        const std::size_t count = system.size();
+        const double *mass = system.mass();
+        for (std::size_t d = 0; d < N; ++d) {
+            const double *x = system.position(d);
+            double *f = system.force(d);
+            for (std::size_t i = 0; i < count; ++i) {
+                f[i] = -stiffness_ * mass[i] * x[i];
+            }
+        }
+    }
+
+    double potentialEnergy(const ParticleSystem<N> &system) const
+    {
+        const double *mass = system.mass();
+        double energy = 0.0;
+        for (std::size_t d = 0; d < N; ++d) {
+            const double *x = system.position(d);
+            for (std::size_t i = 0; i < system.size(); ++i) {
+                energy += mass[i] * x[i] * x[i];
+            }
+        }
+        return 0.5 * stiffness_ * energy;
+    }
+
+private:
+    double stiffness_;
+};
+
+// Reference O(N^2) sum over all pairs
+template <std::size_t N, typename Interaction>
+class DirectForce : public ForceModel<N>
+{
+public:
+    explicit DirectForce(const Interaction &interaction = Interaction()) : interaction_(interaction) {}
+
+    void computeForces(ParticleSystem<N> &system) override
+    {
+        const std::size_t count = system.size();
+        const double *mass = system.mass();
+        for (std::size_t i = 0; i < count; ++i) {
+            Vector<N> total;
+            for (std::size_t j = 0; j < count; ++j) {
+                if (j == i) {
+                    continue;
+                }
+                Vector<N> dx;
+                double r2 = 0.0;
+                for (std::size_t d = 0; d < N; ++d) {
+                    dx[d] = system.position(d)[j] - system.position(d)[i];
+                    r2 += dx[d] * dx[d];
+                }
+                total += interaction_(r2, mass[i], mass[j]) * dx;
+            }
+            for (std::size_t d = 0; d < N; ++d) {
+                system.force(d)[i] = total[d];
+            }
+        }
+    }
+
+private:
+    Interaction interaction_;
+};
+
+// Uniform cell list for interactions with a finite cutoff (Interaction::cutoff). The particles
+// are counting-sorted into cells at least one cutoff wide, so each particle only visits the
+// 3^N cells around its own. The cells are rebuilt every step in O(N), reusing all buffers.
+template <std::size_t N, typename Interaction>
+class CellListForce : public ForceModel<N>
+{
+public:
+    explicit CellListForce(const Interaction &interaction = Interaction()) : interaction_(interaction) {}
+
+    void computeForces(ParticleSystem<N> &system) override
+    {
+        const std::size_t count = system.size();
+        if (count == 0) {
+            return;
+        }
+        build(system);
+
+        const double cutoff2 = interaction_.cutoff * interaction_.cutoff;
+        for (std::size_t s = 0; s < count; ++s) {
+            std::array<std::size_t, N> cell = cellCoordinates(s);
+            Vector<N> total;
+            for (std::size_t neighbour = 0; neighbour < neighbourCount; ++neighbour) {
+                // Decode the offset of this neighbour, -1, 0 or +1 per axis
+                std::size_t code = neighbour;
+                std::size_t c = 0;
+                bool inside = true;
+                for (std::size_t d = 0; d < N; ++d) {
+                    const std::ptrdiff_t k = static_cast<std::ptrdiff_t>(cell[d]) + static_cast<std::ptrdiff_t>(code % 3) - 1;
+                    code /= 3;
+                    if (k < 0 || k >= static_cast<std::ptrdiff_t>(dims_[d])) {
+                        inside = false;
+                        break;
+                    }
+                    c += static_cast<std::size_t>(k) * stride_[d];
+                }
+                if (!inside) {
+                    continue;
+                }
+                for (std::size_t t = cellStart_[c]; t < cellStart_[c + 1]; ++t) {
+                    if (t == s) {
+                        continue;
+                    }
+                    Vector<N> dx;
+                    double r2 = 0.0;
+                    for (std::size_t d = 0; d < N; ++d) {
+                        dx[d] = sortedPosition_[d][t] - sortedPosition_[d][s];
+                        r2 += dx[d] * dx[d];
+                    }
+                    if (r2 < cutoff2) {
+                        total += interaction_(r2, sortedMass_[s], sortedMass_[t]) * dx;
+                    }
+                }
+            }
+            for (std::size_t d = 0; d < N; ++d) {
+                system.force(d)[sorted_[s]] = total[d];
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t neighbourCount = N == 1 ? 3 : N == 2 ? 9 : 27;
+
+    // Sorts the particles by cell and gathers their positions and masses in that order
+    void build(const ParticleSystem<N> &system)
+    {
+        const std::size_t count = system.size();
+        for (std::size_t d = 0; d < N; ++d) {
+            const double *x = system.position(d);
+            if (!std::all_of(x, x + count, [](double value) { return std::isfinite(value); })) {
+                throw std::invalid_argument("CellListForce: Particle positions must be finite.");
+            }
+        }
+        Vector<N> hi;
+        boundingBox(system, lo_, hi);
+        for (std::size_t d = 0; d < N; ++d) {
+            if (!std::isfinite(hi[d] - lo_[d])) {
+                throw std::invalid_argument("CellListForce: Particles are spread too far apart.");
+            }
+        }
+
+        // Cells no narrower than the cutoff; widened while there are far more cells than particles.
+        // The counts are computed in double, so that they cannot wrap before they are compared.
+        cellSize_ = interaction_.cutoff > 0.0 ? interaction_.cutoff : std::numeric_limits<double>::min();
+        const double maxCells = 8.0 * static_cast<double>(count) + 64.0;
+        std::array<double, N> perAxis;
+        for (;;) {
+            double total = 1.0;
+            for (std::size_t d = 0; d < N; ++d) {
+                perAxis[d] = std::floor((hi[d] - lo_[d]) / cellSize_) + 1.0;
+                total *= perAxis[d];
+            }
+            if (total <= maxCells) {
+                break;
+            }
+            cellSize_ *= 2.0;
+        }
+        std::size_t cells = 1;
+        for (std::size_t d = 0; d < N; ++d) {
+            dims_[d] = static_cast<std::size_t>(perAxis[d]);
+            stride_[d] = cells;
+            cells *= dims_[d];
+        }
+
+        cellOf_.resize(count);
+        cellStart_.assign(cells + 1, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::size_t c = 0;
+            for (std::size_t d = 0; d < N; ++d) {
+                c += cellIndex(system.position(d)[i], d) * stride_[d];
+            }
+            cellOf_[i] = c;
+            ++cellStart_[c + 1];
+        }
+        std::partial_sum(cellStart_.begin(), cellStart_.end(), cellStart_.begin());
+
+        cursor_.assign(cellStart_.begin(), cellStart_.end() - 1);
+        sorted_.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            sorted_[cursor_[cellOf_[i]]++] = i;
+        }
+
+        for (std::size_t d = 0; d < N; ++d) {
+            sortedPosition_[d].resize(count);
+            for (std::size_t s = 0; s < count; ++s) {
+                sortedPosition_[d][s] = system.position(d)[sorted_[s]];
+            }
+        }
+        sortedMass_.resize(count);
+        for (std::size_t s = 0; s < count; ++s) {
+            sortedMass_[s] = system.mass()[sorted_[s]];
+        }
+    }
+
+    std::size_t cellIndex(double x, std::size_t d) const
+    {
+        return std::min(dims_[d] - 1, static_cast<std::size_t>((x - lo_[d]) / cellSize_));
+    }
+
+    std::array<std::size_t, N> cellCoordinates(std::size_t s) const
+    {
+        std::array<std::size_t, N> cell;
+        for (std::size_t d = 0; d < N; ++d) {
+            cell[d] = cellIndex(sortedPosition_[d][s], d);
+        }
+        return cell;
+    }
+
+    Interaction interaction_;
+    Vector<N> lo_;
+    double cellSize_ = 0.0;
+    std::array<std::size_t, N> dims_{};
+    std::array<std::size_t, N> stride_{};
+    std::vector<std::size_t> cellOf_;
+    std::vector<std::size_t> cellStart_;
+    std::vector<std::size_t> cursor_;
+    std::vector<std::size_t> sorted_;
+    std::array<std::vector<double>, N> sortedPosition_;
+    std::vector<double> sortedMass_;
+};
+
+// Barnes-Hut tree (quadtree for N = 2, octree for N = 3) for gravity. Particles are sorted
+// into tree order so every node covers a contiguous range of them; a node whose extent is
+// below theta times its distance acts as a single mass at its centre of mass, which makes a
+// step O(N log N). theta = 0 opens every node and gives the direct sum.
+//
+// The tree is rebuilt every rebuildInterval steps. In between it is refitted: the topology is
+// kept and the masses, centres of mass and bounding boxes are recomputed from the moved
+// particles in O(N). The boxes are exact, so the opening test stays conservative as particles
+// drift; only the tree gets less balanced, which is why it is rebuilt from time to time.
+template <std::size_t N>
+class BarnesHutForce : public ForceModel<N>
+{
+public:
+    explicit BarnesHutForce(const Gravity &gravity = Gravity(), double theta = 0.5, std::size_t leafSize = 8,
+                            unsigned rebuildInterval = 1)
+        : gravity_(gravity), theta_(theta), leafSize_(std::max<std::size_t>(leafSize, 1)),
+          rebuildInterval_(std::max(rebuildInterval, 1u))
+    {
+    }
+
+    void computeForces(ParticleSystem<N> &system) override
+    {
+        const std::size_t count = system.size();
+        if (count == 0) {
+            return;
+        }
+        if (order_.size() != count || stepsSinceBuild_ >= rebuildInterval_) {
+            build(system);
+            stepsSinceBuild_ = 0;
+        }
+        refit(system);
+        ++stepsSinceBuild_;
+
+        const double theta2 = theta_ * theta_;
+        for (std::size_t k = 0; k < count; ++k) {
+            Vector<N> xi;
+            for (std::size_t d = 0; d < N; ++d) {
+                xi[d] = sortedPosition_[d][k];
+            }
+            const double mi = sortedMass_[k];
+            Vector<N> total;
+
+            stack_.assign(1, 0);
+            while (!stack_.empty()) {
+                const Node &node = nodes_[stack_.back()];
+                stack_.pop_back();
+
+                if (node.childCount == 0) {
+                    for (std::uint32_t m = node.begin; m < node.end; ++m) {
+                        if (m == k) {
+                            continue;
+                        }
+                        Vector<N> dx;
+                        double r2 = 0.0;
+                        for (std::size_t d = 0; d < N; ++d) {
+                            dx[d] = sortedPosition_[d][m] - xi[d];
+                            r2 += dx[d] * dx[d];
+                        }
+                        total += gravity_(r2, mi, sortedMass_[m]) * dx;
+                    }
+                    continue;
+                }
+
+                Vector<N> dx = node.centerOfMass - xi;
+                double r2 = dx * dx;
+                double size = 0.0;
+                bool inside = true;
+                for (std::size_t d = 0; d < N; ++d) {
+                    size = std::max(size, node.hi[d] - node.lo[d]);
+                    inside = inside && xi[d] >= node.lo[d] && xi[d] <= node.hi[d];
+                }
+                if (!inside && size * size < theta2 * r2) {
+                    total += gravity_(r2, mi, node.mass) * dx;
+                } else {
+                    for (std::uint32_t c = 0; c < node.childCount; ++c) {
+                        stack_.push_back(node.firstChild + c);
+                    }
+                }
+            }
+
+            for (std::size_t d = 0; d < N; ++d) {
+                system.force(d)[order_[k]] = total[d];
+            }
+        }
+    }
+
+    // Number of tree nodes, for diagnostics
+    std::size_t nodeCount() const { return nodes_.size(); }
+
+private:
+    static constexpr std::size_t childrenPerNode = std::size_t(1) << N;
+    static constexpr unsigned maxDepth = 48; // coincident particles end up in one leaf
+
+    struct Node
+    {
+        Vector<N> lo, hi;
+        Vector<N> centerOfMass;
+        double mass = 0.0;
+        std::uint32_t begin = 0, end = 0;   // range of particles in tree order
+        std::uint32_t firstChild = 0;       // children are stored next to each other
+        std::uint32_t childCount = 0;       // 0 for leaves
+    };
+
+    void build(const ParticleSystem<N> &system)
+    {
+        const std::size_t count = system.size();
+        order_.resize(count);
+        std::iota(order_.begin(), order_.end(), std::size_t(0));
+        scratch_.resize(count);
+
+        // Cubic root cell around all particles
+        Vector<N> lo, hi;
+        boundingBox(system, lo, hi);
+        Vector<N> center = 0.5 * (lo + hi);
+        double half = 0.0;
+        for (std::size_t d = 0; d < N; ++d) {
+            half = std::max(half, 0.5 * (hi[d] - lo[d]));
+        }
+        half = half * (1.0 + 1e-12) + 1e-300;
+
+        nodes_.clear();
+        nodes_.emplace_back();
+        nodes_[0].begin = 0;
+        nodes_[0].end = static_cast<std::uint32_t>(count);
+        split(system, 0, center, half, 0);
+    }
+
+    // Partitions the particles of a node into the 2^N children of its cell, recursively
+    void split(const ParticleSystem<N> &system, std::uint32_t index, const Vector<N> &center, double half, unsigned depth)
+    {
+        const std::uint32_t begin = nodes_[index].begin;
+        const std::uint32_t end = nodes_[index].end;
+        if (end - begin <= leafSize_ || depth >= maxDepth) {
+            return;
+        }
+
+        auto childOf = [&](std::size_t i) {
+            std::size_t child = 0;
+            for (std::size_t d = 0; d < N; ++d) {
+                if (system.position(d)[i] >= center[d]) {
+                    child |= std::size_t(1) << d;
+                }
+            }
+            return child;
+        };
+
+        // Counting sort of the node's particles by child
+        std::array<std::uint32_t, childrenPerNode + 1> start{};
+        for (std::uint32_t k = begin; k < end; ++k) {
+            ++start[childOf(order_[k]) + 1];
+        }
+        start[0] = begin;
+        std::partial_sum(start.begin(), start.end(), start.begin());
+        std::array<std::uint32_t, childrenPerNode> cursor;
+        std::copy(start.begin(), start.end() - 1, cursor.begin());
+        for (std::uint32_t k = begin; k < end; ++k) {
+            scratch_[cursor[childOf(order_[k])]++] = order_[k];
+        }
+        std::copy(scratch_.begin() + begin, scratch_.begin() + end, order_.begin() + begin);
+
+        const std::uint32_t firstChild = static_cast<std::uint32_t>(nodes_.size());
+        std::array<std::size_t, childrenPerNode> childCode;
+        std::uint32_t childCount = 0;
+        for (std::size_t child = 0; child < childrenPerNode; ++child) {
+            if (start[child] < start[child + 1]) {
+                Node node;
+                node.begin = start[child];
+                node.end = start[child + 1];
+                nodes_.push_back(node);
+                childCode[childCount++] = child;
+            }
+        }
+        nodes_[index].firstChild = firstChild;
+        nodes_[index].childCount = childCount;
+
+        for (std::uint32_t c = 0; c < childCount; ++c) {
+            Vector<N> childCenter = center;
+            for (std::size_t d = 0; d < N; ++d) {
+                childCenter[d] += (childCode[c] >> d & 1) ? 0.5 * half : -0.5 * half;
+            }
+            split(system, firstChild + c, childCenter, 0.5 * half, depth + 1);
+        }
+    }
+
+    // Gathers the particles in tree order and recomputes every node bottom-up. Children are
+    // stored after their parent, so a reverse sweep visits them first.
+    void refit(const ParticleSystem<N> &system)
+    {
+        const std::size_t count = order_.size();
+        for (std::size_t d = 0; d < N; ++d) {
+            sortedPosition_[d].resize(count);
+            for (std::size_t k = 0; k < count; ++k) {
+                sortedPosition_[d][k] = system.position(d)[order_[k]];
+            }
+        }
+        sortedMass_.resize(count);
+        for (std::size_t k = 0; k < count; ++k) {
+            sortedMass_[k] = system.mass()[order_[k]];
+        }
+
+        for (std::size_t n = nodes_.size(); n-- > 0;) {
+            Node &node = nodes_[n];
+            node.mass = 0.0;
+            Vector<N> weighted;
+            if (node.childCount == 0) {
+                for (std::size_t d = 0; d < N; ++d) {
+                    node.lo[d] = sortedPosition_[d][node.begin];
+                    node.hi[d] = sortedPosition_[d][node.begin];
+                }
+                for (std::uint32_t k = node.begin; k < node.end; ++k) {
+                    node.mass += sortedMass_[k];
+                    for (std::size_t d = 0; d < N; ++d) {
+                        const double x = sortedPosition_[d][k];
+                        weighted[d] += sortedMass_[k] * x;
+                        node.lo[d] = std::min(node.lo[d], x);
+                        node.hi[d] = std::max(node.hi[d], x);
+                    }
+                }
+            } else {
+                node.lo = nodes_[node.firstChild].lo;
+                node.hi = nodes_[node.firstChild].hi;
+                for (std::uint32_t c = 0; c < node.childCount; ++c) {
+                    const Node &child = nodes_[node.firstChild + c];
+                    node.mass += child.mass;
+                    weighted += child.mass * child.centerOfMass;
+                    for (std::size_t d = 0; d < N; ++d) {
+                        node.lo[d] = std::min(node.lo[d], child.lo[d]);
+                        node.hi[d] = std::max(node.hi[d], child.hi[d]);
+                    }
+                }
+            }
+            if (node.mass > 0.0) {
+                node.centerOfMass = (1.0 / node.mass) * weighted;
+            } else {
+                node.centerOfMass = 0.5 * (node.lo + node.hi);
+            }
+        }
+    }
+
+    Gravity gravity_;
+    double theta_;
+    std::size_t leafSize_;
+    unsigned rebuildInterval_;
+    unsigned stepsSinceBuild_ = 0;
+    std::vector<Node> nodes_;
+    std::vector<std::size_t> order_;
+    std::vector<std::size_t> scratch_;
+    std::array<std::vector<double>, N> sortedPosition_;
+    std::vector<double> sortedMass_;
+    std::vector<std::uint32_t> stack_;
+};
+
+#endif // FORCES_H
@@ -0,0 +1,63 @@
+#ifndef HEAP_VECTOR_H
+#define HEAP_VECTOR_H
+
+#include <cstddef>
+#include <vector>
+
+// The original std::vector-backed Vector, kept only as the baseline for the benchmarks:
+// every arithmetic operator returns a new heap-allocated vector
+class HeapVector
+{
+public:
+    explicit HeapVector(const std::vector<double> &components) : components_(components) {}
+
+    HeapVector operator+(const HeapVector &other) const
+    {
+        std::vector<double> result(components_.size());
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = components_[i] + other.components_[i];
+        }
+        return HeapVector(result);
+    }
+
+    HeapVector operator-(const HeapVector &other) const
+    {
+        std::vector<double> result(components_.size());
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = components_[i] - other.components_[i];
+        }
+        return HeapVector(result);
+    }
+
+    HeapVector operator*(double scalar) const
+    {
+        std::vector<double> result(components_.size());
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            result[i] = components_[i] * scalar;
+        }
+        return HeapVector(result);
+    }
+
+    friend HeapVector operator*(double scalar, const HeapVector &v)
+    {
+        return v * scalar;
+    }
+
+    double operator*(const HeapVector &other) const
+    {
+        double dotProduct = 0.0;
+        for (std::size_t i = 0; i < components_.size(); ++i) {
+            dotProduct += components_[i] * other.components_[i];
+        }
+        return dotProduct;
+    }
+
+    double operator[](std::size_t i) const {
+        return components_[i];
+    }
+
+private:
+    std::vector<double> components_;
+};
+
+#endif // HEAP_VECTOR_H
@@ -0,0 +1,113 @@
+#ifndef INTEGRATORS_H
+#define INTEGRATORS_H
+
+#include <cstddef>
+#include "particle_system.h"
+#include "forces.h"
+
+// Pluggable time integration: advances every particle of the system by dt, asking the force
+// model for new forces as needed. An integrator may keep state between steps (valid forces,
+// staggered velocities), so one instance belongs to one simulation.
+template <std::size_t N>
+class Integrator
+{
+public:
+    virtual ~Integrator() = default;
+    virtual void step(ParticleSystem<N> &system, ForceModel<N> &forces, double dt) = 0;
+
+    // Brings the velocities to the time of the positions, e.g. before measuring energies.
+    // Only the staggered schemes need this.
+    virtual void synchronize(ParticleSystem<N> &system, ForceModel<N> &forces)
+    {
+        (void)system;
+        (void)forces;
+    }
+};
+
+// The step of Particle::update with forces from the model: first order, so the energy drifts
+// in proportion to dt
+template <std::size_t N>
+class EulerIntegrator : public Integrator<N>
+{
+public:
+    void step(ParticleSystem<N> &system, ForceModel<N> &forces, double dt) override
+    {
+        forces.computeForces(system);
+        system.kickDrift(dt, dt);
+    }
+};
+
+// Velocity Verlet: half kick fused with the drift, new forces, second half kick. Second order
+// and symplectic, with positions and velocities at the same time after every step. The forces
+// of the end of one step are those of the start of the next, so they are computed once per
+// step; they are recomputed only on the first step or after the system was changed from
+// outside (call reset()).
+template <std::size_t N>
+class VelocityVerlet : public Integrator<N>
+{
+public:
+    void step(ParticleSystem<N> &system, ForceModel<N> &forces, double dt) override
+    {
+        if (!forcesValid_) {
+            forces.computeForces(system);
+            forcesValid_ = true;
+        }
+        system.kickDrift(0.5 * dt, dt);
+        forces.computeForces(system);
+        system.kick(0.5 * dt);
+    }
+
+    void reset() { forcesValid_ = false; }
+
+private:
+    bool forcesValid_ = false;
+};
+
+// Leapfrog (kick-drift): the velocities live half a step behind the positions, so the closing
+// half kick of one Verlet step and the opening half kick of the next merge into one, and a
+// step is a single fused pass over memory. Same trajectory as VelocityVerlet; the first step
+// kicks by dt / 2 to stagger the velocities, and synchronize() undoes the stagger. dt must
+// stay the same between those two points.
+template <std::size_t N>
+class Leapfrog : public Integrator<N>
+{
+public:
+    void step(ParticleSystem<N> &system, ForceModel<N> &forces, double dt) override
+    {
+        forces.computeForces(system);
+        system.kickDrift(staggered_ ? dt : 0.5 * dt, dt);
+        staggered_ = true;
+        dt_ = dt;
+    }
+
+    void synchronize(ParticleSystem<N> &system, ForceModel<N> &forces) override
+    {
+        if (!staggered_) {
+            return;
+        }
+        forces.computeForces(system);
+        system.kick(0.5 * dt_);
+        staggered_ = false;
+    }
+
+private:
+    bool staggered_ = false;
+    double dt_ = 0.0;
+};
+
+// Total kinetic energy, sum of m |v|^2 / 2
+template <std::size_t N>
+double kineticEnergy(const ParticleSystem<N> &system)
+{
+    const double *mass = system.mass();
+    double energy = 0.0;
+    for (std::size_t d = 0; d < N; ++d) {
+        const double *v = system.velocity(d);
+        for (std::size_t i = 0; i < system.size(); ++i) {
+            energy += mass[i] * v[i] * v[i];
+        }
+    }
+    return 0.5 * energy;
+}
+
+#endif // INTEGRATORS_H
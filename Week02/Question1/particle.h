@@ -0,0 +1,102 @@
+#ifndef PARTICLE_H
+#define PARTICLE_H
+
+#include <cstddef>
+#include <iostream>
+#include "vector.h"
+
+// Build with PARTICLE_TRACE_LIFECYCLE=1 to have every Particle report its construction and
+// destruction on std::cout. Off by default: the trace flushes once per particle, and without
+// it Particle is trivially destructible, so arrays of particles are freed without a loop.
+#ifndef PARTICLE_TRACE_LIFECYCLE
+#define PARTICLE_TRACE_LIFECYCLE 0
+#endif
+
+// Particle class to represent particles in N-dimensional space (N = 2 or 3)
+template <std::size_t N>
+class Particle
+{
+public:
+    // Constructor to initialize particle properties
+    Particle(double mass, const Vector<N> &position, const Vector<N> &velocity, const Vector<N> &force)
+        : mass_(mass), position_(position), velocity_(velocity), force_(force)
+    {
+#if PARTICLE_TRACE_LIFECYCLE
+        std::cout << "Particle created at position " << position_ << std::endl;
+#endif
+    }
+
+#if PARTICLE_TRACE_LIFECYCLE
+    Particle(const Particle &) = default;
+    Particle(Particle &&) = default;
+    Particle &operator=(const Particle &) = default;
+    Particle &operator=(Particle &&) = default;
+
+    // Destructor to indicate when a particle is destroyed
+    ~Particle()
+    {
+        std::cout << "Particle destroyed at position " << position_ << std::endl;
+    }
+#endif
+
+    // Function to update the position of the particle based on time
+    void updatePosition(double time)
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            position_[i] += velocity_[i] * time;
+        }
+    }
+
+    // Function to print the current state of the particle
+    void printState() const
+    {
+        std::cout << "Particle - Mass: " << mass_ << ", Position: " << position_
+                  << ", Velocity: " << velocity_ << ", Speed: " << norm<L2Norm>(velocity_) << std::endl;
+    }
+
+    // Function to update particle properties at time t, using time step dt
+    // Component-wise in place: no temporaries and no allocations
+    void update(double t, double dt)
+    {
+        (void)t;
+        const double inverseMass = 1.0 / mass_;
+        for (std::size_t i = 0; i < N; ++i) {
+            velocity_[i] += force_[i] * inverseMass * dt;
+            position_[i] += velocity_[i] * dt;
+        }
+    }
+
+    // Function to get the current position of the particle
+    const Vector<N>& getPosition() const {
+        return position_;
+    }
+
+    const Vector<N>& getVelocity() const {
+        return velocity_;
+    }
+
+private:
+    double mass_;
+    Vector<N> position_;
+    Vector<N> velocity_;
+    Vector<N> force_;
+};
+
+// Norms of the velocities of count particles, out[i] = norm<Kind>(particles[i].getVelocity())
+template <typename Kind, std::size_t N>
+void speeds(const Particle<N> *particles, std::size_t count, double *out)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = norm<Kind>(particles[i].getVelocity());
+    }
+}
+
+// Function to calculate force based on a vector and time
+// Example implementation: force is proportional to the vector components and time
+template <std::size_t N>
+Vector<N> force(const Vector<N> &v, double t)
+{
+    return v * t;
+}
+
+#endif // PARTICLE_H
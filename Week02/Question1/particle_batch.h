@@ -0,0 +1,38 @@
+#ifndef PARTICLE_BATCH_H
+#define PARTICLE_BATCH_H
+
+#include <cstddef>
+#include <vector>
+#include "particle.h"
+#include "../../common/worker_pool.h"
+
+// Builds count particles from contiguous arrays of masses, positions, velocities and forces
+// with a single allocation; nothing is printed unless PARTICLE_TRACE_LIFECYCLE is set
+template <std::size_t N>
+std::vector<Particle<N>> makeParticles(const double *mass, const Vector<N> *position, const Vector<N> *velocity,
+                                       const Vector<N> *force, std::size_t count)
+{
+    std::vector<Particle<N>> particles;
+    particles.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        particles.emplace_back(mass[i], position[i], velocity[i], force[i]);
+    }
+    return particles;
+}
+
+// Function to update all particles at time t, using time step dt, on the threads of the pool.
+// Each thread steps one contiguous range of the vector, and the ranges start on cache-line
+// boundaries so that no two threads write to the same cache line. The particles are
+// independent, so the result is the same as calling update on each of them in turn.
+template <std::size_t N>
+void updateParticles(std::vector<Particle<N>> &particles, double t, double dt, WorkerPool &pool)
+{
+    Particle<N> *data = particles.data();
+    parallel_for_cache_aligned(pool, data, particles.size(), [=](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            data[i].update(t, dt);
+        }
+    });
+}
+
+#endif // PARTICLE_BATCH_H
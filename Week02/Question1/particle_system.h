@@ -0,0 +1,202 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include "vector.h"
+
+template <std::size_t N>
+class ParticleSystem;
+
+// Particle-like handle on one particle of a ParticleSystem. Reads gather the components into a
+// Vector, writes scatter them back; the view is invalidated when particles are added.
+template <std::size_t N>
+class ParticleView
+{
+public:
+    ParticleView(ParticleSystem<N> &system, std::size_t index) : system_(&system), index_(index) {}
+
+    double getMass() const { return system_->mass()[index_]; }
+    Vector<N> getPosition() const { return gather(system_->position_); }
+    Vector<N> getVelocity() const { return gather(system_->velocity_); }
+    Vector<N> getForce() const { return gather(system_->force_); }
+
+    void setPosition(const Vector<N> &position) { scatter(system_->position_, position); }
+    void setVelocity(const Vector<N> &velocity) { scatter(system_->velocity_, velocity); }
+    void setForce(const Vector<N> &force) { scatter(system_->force_, force); }
+
+    // Function to update the position of the particle based on time
+    void updatePosition(double time)
+    {
+        for (std::size_t d = 0; d < N; ++d) {
+            system_->position_[d][index_] += system_->velocity_[d][index_] * time;
+        }
+    }
+
+    // Same explicit Euler step as Particle::update, for this particle only
+    void update(double t, double dt)
+    {
+        (void)t;
+        const double inverseMass = system_->inverseMass_[index_];
+        for (std::size_t d = 0; d < N; ++d) {
+            system_->velocity_[d][index_] += system_->force_[d][index_] * inverseMass * dt;
+            system_->position_[d][index_] += system_->velocity_[d][index_] * dt;
+        }
+    }
+
+    // Function to print the current state of the particle
+    void printState() const
+    {
+        std::cout << "Particle - Mass: " << getMass() << ", Position: " << getPosition()
+                  << ", Velocity: " << getVelocity() << ", Speed: " << norm<L2Norm>(getVelocity()) << std::endl;
+    }
+
+private:
+    Vector<N> gather(const std::array<std::vector<double>, N> &field) const
+    {
+        Vector<N> v;
+        for (std::size_t d = 0; d < N; ++d) {
+            v[d] = field[d][index_];
+        }
+        return v;
+    }
+
+    void scatter(std::array<std::vector<double>, N> &field, const Vector<N> &v)
+    {
+        for (std::size_t d = 0; d < N; ++d) {
+            field[d][index_] = v[d];
+        }
+    }
+
+    ParticleSystem<N> *system_;
+    std::size_t index_;
+};
+
+// Structure-of-arrays container for many particles: each component of the position, velocity
+// and force, and the mass, is a contiguous array over all particles (x[], y[], z[], vx[], ...),
+// so update() streams through memory in unit stride and the compiler vectorizes it.
+template <std::size_t N>
+class ParticleSystem
+{
+public:
+    ParticleSystem() = default;
+
+    // count particles of mass 1 at rest at the origin, with no force
+    explicit ParticleSystem(std::size_t count) : mass_(count, 1.0), inverseMass_(count, 1.0)
+    {
+        for (std::size_t d = 0; d < N; ++d) {
+            position_[d].assign(count, 0.0);
+            velocity_[d].assign(count, 0.0);
+            force_[d].assign(count, 0.0);
+        }
+    }
+
+    std::size_t size() const { return mass_.size(); }
+
+    void reserve(std::size_t count)
+    {
+        mass_.reserve(count);
+        inverseMass_.reserve(count);
+        for (std::size_t d = 0; d < N; ++d) {
+            position_[d].reserve(count);
+            velocity_[d].reserve(count);
+            force_[d].reserve(count);
+        }
+    }
+
+    // Appends a particle and returns its index
+    std::size_t add(double mass, const Vector<N> &position, const Vector<N> &velocity, const Vector<N> &force)
+    {
+        mass_.push_back(mass);
+        inverseMass_.push_back(1.0 / mass);
+        for (std::size_t d = 0; d < N; ++d) {
+            position_[d].push_back(position[d]);
+            velocity_[d].push_back(velocity[d]);
+            force_[d].push_back(force[d]);
+        }
+        return mass_.size() - 1;
+    }
+
+    ParticleView<N> operator[](std::size_t i) { return ParticleView<N>(*this, i); }
+
+    // Contiguous component arrays, e.g. position(0) is x[] and velocity(2) is vz[]
+    double *position(std::size_t d) { return position_[d].data(); }
+    double *velocity(std::size_t d) { return velocity_[d].data(); }
+    double *force(std::size_t d) { return force_[d].data(); }
+    const double *position(std::size_t d) const { return position_[d].data(); }
+    const double *velocity(std::size_t d) const { return velocity_[d].data(); }
+    const double *force(std::size_t d) const { return force_[d].data(); }
+    const double *mass() const { return mass_.data(); }
+    const double *inverseMass() const { return inverseMass_.data(); }
+
+    // Norms of all velocities, out[i] = norm<Kind>(v_i); e.g. speeds<L2Norm>(out)
+    template <typename Kind>
+    void speeds(double *out) const
+    {
+        std::array<const double *, N> components;
+        for (std::size_t d = 0; d < N; ++d) {
+            components[d] = velocity_[d].data();
+        }
+        norms<Kind>(components, size(), out);
+    }
+
+    // Masses are set through here so that the cached inverse stays in step
+    void setMass(std::size_t i, double mass)
+    {
+        mass_[i] = mass;
+        inverseMass_[i] = 1.0 / mass;
+    }
+
+    // The explicit Euler step of Particle::update applied to all particles, one component
+    // array at a time. 1 / mass is cached per particle instead of divided per component;
+    // it is the value Particle::update computes, so the results are identical.
+    void update(double t, double dt)
+    {
+        (void)t;
+        kickDrift(dt, dt);
+    }
+
+    // Fused kick and drift in one pass over memory: v += kick * F / m, then x += drift * v.
+    // The building block of the integrators in integrators.h.
+    void kickDrift(double kick, double drift)
+    {
+        const std::size_t count = size();
+        const double *__restrict inverseMass = inverseMass_.data();
+        for (std::size_t d = 0; d < N; ++d) {
+            const double *__restrict f = force_[d].data();
+            double *__restrict v = velocity_[d].data();
+            double *__restrict x = position_[d].data();
+            for (std::size_t i = 0; i < count; ++i) {
+                v[i] += f[i] * inverseMass[i] * kick;
+                x[i] += v[i] * drift;
+            }
+        }
+    }
+
+    // Velocity only: v += kick * F / m
+    void kick(double kick)
+    {
+        const std::size_t count = size();
+        const double *__restrict inverseMass = inverseMass_.data();
+        for (std::size_t d = 0; d < N; ++d) {
+            const double *__restrict f = force_[d].data();
+            double *__restrict v = velocity_[d].data();
+            for (std::size_t i = 0; i < count; ++i) {
+                v[i] += f[i] * inverseMass[i] * kick;
+            }
+        }
+    }
+
+private:
+    friend class ParticleView<N>;
+
+    std::array<std::vector<double>, N> position_;
+    std::array<std::vector<double>, N> velocity_;
+    std::array<std::vector<double>, N> force_;
+    std::vector<double> mass_;
+    std::vector<double> inverseMass_;
+};
+
+#endif // PARTICLE_SYSTEM_H
@@ -1,26 +1,31 @@
+import struct
+import numpy as np
 import matplotlib.pyplot as plt
 
-# Function to read data from a file
+# Function to read a binary trajectory file written by TrajectoryWriter: a 24-byte header
+# (magic, version, dimensions, particles, frames) and frames of the time and the positions
+# of one component after the other. Returns the time and the x, y, z positions of particle 0.
 def read_data(filename):
-    time = []
-    x = []
-    y = []
-    z = []
-    with open(filename, 'r') as file:
-        for line in file:
-            values = line.split()
-            time.append(float(values[0]))
-            x.append(float(values[1]))
-            y.append(float(values[2]))
-            if len(values) > 3:
-                z.append(float(values[3]))
+    with open(filename, 'rb') as file:
+        magic, version, dims, particles, frames = struct.unpack('<4sHHQQ', file.read(24))
+        if magic != b'PTRJ' or version != 1:
+            raise ValueError(filename + ' is not a trajectory file')
+        data = np.fromfile(file, dtype='<f8')
+    frame_size = 1 + dims * particles
+    if frames == 0:
+        frames = len(data) // frame_size
+    data = data[:frames * frame_size].reshape(frames, frame_size)
+    time = data[:, 0]
+    x = data[:, 1]
+    y = data[:, 1 + particles]
+    z = data[:, 1 + 2 * particles] if dims > 2 else []
     return time, x, y, z
 
 # Read 2D trajectory data
-time_2d, x_2d, y_2d, _ = read_data('traject_2d.txt')
+time_2d, x_2d, y_2d, _ = read_data('traject_2d.bin')
 
 # Read 3D trajectory data
-time_3d, x_3d, y_3d, z_3d = read_data('traject_3d.txt')
+time_3d, x_3d, y_3d, z_3d = read_data('traject_3d.bin')
 
 # Plot 2D trajectory
 plt.figure()
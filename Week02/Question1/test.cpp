@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
-#include "./homework2_skeleton.cpp"  // Adjust the include path based on your project structure
+#include "vector.h"
+#include "particle.h"
+#include "particle_system.h"
+#include "particle_batch.h"
+#include "forces.h"
+#include "integrators.h"
+#include "trajectory.h"
 
 // Test Vector class
 
@@ -58,12 +64,71 @@ TEST(VectorTest, NormL2) {
     EXPECT_NEAR(result, 3.74166, 1e-5);
 }
 
+TEST(VectorTest, CheckedAccess) {
+    Vector v(1.0, 2.0);
+    EXPECT_EQ(v.at(1), 2.0);
+    EXPECT_THROW(v.at(2), std::out_of_range);
+}
+
+TEST(VectorTest, DeducedDimension) {
+    Vector v2(1.0, 2.0);
+    Vector v3(1.0, 2.0, 3.0);
+    static_assert(decltype(v2)::size() == 2, "Vector(x, y) must be a Vector<2>");
+    static_assert(decltype(v3)::size() == 3, "Vector(x, y, z) must be a Vector<3>");
+    static_assert(sizeof(Vec3) == 3 * sizeof(double), "Vector must store its components inline");
+    constexpr Vec2 sum = Vec2(1.0, 2.0) + Vec2(3.0, 4.0);
+    static_assert(sum[0] == 4.0 && sum[1] == 6.0, "Vector arithmetic must be usable in constant expressions");
+}
+
+TEST(VectorTest, ExpressionChain) {
+    Vector v1(1.0, 2.0);
+    Vector v2(3.0, 4.0);
+    EXPECT_EQ((2. * v1 + 3. * v2) * (v1 + v2), 140.0);
+    auto scaled = (v1 + v2) * 2.0; // holds the sum by value, so it does not dangle
+    Vector result = scaled - v1;
+    EXPECT_EQ(result[0], 7.0);
+    EXPECT_EQ(result[1], 10.0);
+    v1 = v2 - v1 * 0.5; // assigning an expression that reads the target
+    EXPECT_EQ(v1[0], 2.5);
+    EXPECT_EQ(v1[1], 3.0);
+    EXPECT_NEAR(norm(v1 + v2, "L2"), std::sqrt(5.5 * 5.5 + 49.0), 1e-12);
+}
+
 TEST(VectorTest, NormLinf) {
     Vector v(1.0, -2.0, 3.0);
     double result = norm(v, "Linf");
     EXPECT_EQ(result, 3.0);
 }
 
+TEST(VectorTest, CompileTimeNorms) {
+    Vector v(1.0, -2.0, 3.0);
+    EXPECT_EQ(norm<L1Norm>(v), norm(v, "L1"));
+    EXPECT_EQ(norm<L2Norm>(v), norm(v, "L2"));
+    EXPECT_EQ(norm<LinfNorm>(v), norm(v, "Linf"));
+    EXPECT_EQ(norm<SquaredL2Norm>(v), 14.0);
+    EXPECT_EQ(norm<SquaredL2Norm>(v - v), 0.0);
+    EXPECT_THROW(norm(v, "L3"), std::invalid_argument);
+}
+
+TEST(VectorTest, BatchedNormsMatchSingle) {
+    std::vector<Vec3> vectors;
+    ParticleSystem<3> system;
+    for (int i = 0; i < 37; ++i) {
+        Vector v(0.5 * i, -1.0 + 0.1 * i, std::sin(double(i)));
+        vectors.push_back(v);
+        system.add(1.0, Vec3(), v, Vec3());
+    }
+    std::vector<double> batched(vectors.size()), strided(vectors.size());
+    norms<L2Norm>(vectors.data(), vectors.size(), batched.data());
+    system.speeds<L2Norm>(strided.data());
+    for (std::size_t i = 0; i < vectors.size(); ++i) {
+        EXPECT_EQ(batched[i], norm<L2Norm>(vectors[i]));
+        EXPECT_EQ(strided[i], batched[i]);
+    }
+    system.speeds<LinfNorm>(strided.data());
+    EXPECT_EQ(strided[20], 10.0);
+}
+
 // Test Particle class
 
 TEST(ParticleTest, Initialization2D) {
@@ -103,7 +168,300 @@ TEST(ParticleTest, ForceCalculation) {
     EXPECT_EQ(result[1], 4.0);
 }
 
+TEST(ParticleTest, BulkConstruction) {
+    static_assert(std::is_trivially_destructible_v<Particle<3>>, "Particle must not trace unless asked to");
+    const double mass[] = {1.0, 2.0, 4.0};
+    const Vec2 position[] = {Vec2(0.0, 1.0), Vec2(2.0, 3.0), Vec2(4.0, 5.0)};
+    const Vec2 velocity[] = {Vec2(1.0, 0.0), Vec2(0.0, 1.0), Vec2(-1.0, 0.0)};
+    const Vec2 force[] = {Vec2(0.0, 0.0), Vec2(2.0, 0.0), Vec2(0.0, 4.0)};
+    std::vector<Particle<2>> particles = makeParticles(mass, position, velocity, force, 3);
+    ASSERT_EQ(particles.size(), 3u);
+    EXPECT_EQ(particles[1].getPosition()[0], 2.0);
+    particles[2].update(0.0, 1.0);
+    EXPECT_EQ(particles[2].getVelocity()[1], 1.0);
+    EXPECT_EQ(particles[2].getPosition()[1], 6.0);
+}
+
+// Test ParticleSystem class
+
+TEST(ParticleSystemTest, UpdateMatchesParticle) {
+    ParticleSystem<3> system;
+    std::vector<Particle<3>> particles;
+    particles.reserve(17);
+    for (int i = 0; i < 17; ++i) {
+        Vector position(0.1 * i, -0.2 * i, 1.0);
+        Vector velocity(1.0, 0.5 * i, -0.25);
+        Vector force(0.3 * i, -1.0, 0.7);
+        double mass = 1.0 + 0.25 * i;
+        system.add(mass, position, velocity, force);
+        particles.emplace_back(mass, position, velocity, force);
+    }
+    for (int step = 0; step < 10; ++step) {
+        system.update(0.0, 0.01);
+        for (auto &p : particles) {
+            p.update(0.0, 0.01);
+        }
+    }
+    for (std::size_t i = 0; i < particles.size(); ++i) {
+        for (std::size_t d = 0; d < 3; ++d) {
+            EXPECT_EQ(system[i].getPosition()[d], particles[i].getPosition()[d]);
+            EXPECT_EQ(system.velocity(d)[i], particles[i].getVelocity()[d]);
+        }
+    }
+}
+
+TEST(ParticleSystemTest, ViewUpdatesOneParticle) {
+    ParticleSystem<2> system(3);
+    system[1].setVelocity(Vector(1.0, 2.0));
+    system[1].updatePosition(2.0);
+    EXPECT_EQ(system[1].getPosition()[0], 2.0);
+    EXPECT_EQ(system[1].getPosition()[1], 4.0);
+    EXPECT_EQ(system.position(0)[0], 0.0);
+    EXPECT_EQ(system.position(1)[2], 0.0);
+}
+
+// Test the parallel batch update
+
+TEST(ParticleBatchTest, UpdateMatchesSerial) {
+    std::vector<Particle<3>> serial, parallel;
+    serial.reserve(101);
+    parallel.reserve(101);
+    for (int i = 0; i < 101; ++i) {
+        Vector position(0.1 * i, -0.2 * i, 1.0);
+        Vector velocity(1.0, 0.5 * i, -0.25);
+        Vector force(0.3 * i, -1.0, 0.7);
+        serial.emplace_back(1.0 + 0.25 * i, position, velocity, force);
+        parallel.emplace_back(1.0 + 0.25 * i, position, velocity, force);
+    }
+    WorkerPool pool(3);
+    for (int step = 0; step < 10; ++step) {
+        updateParticles(parallel, 0.0, 0.01, pool);
+        for (auto &p : serial) {
+            p.update(0.0, 0.01);
+        }
+    }
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        for (std::size_t d = 0; d < 3; ++d) {
+            EXPECT_EQ(parallel[i].getPosition()[d], serial[i].getPosition()[d]);
+            EXPECT_EQ(parallel[i].getVelocity()[d], serial[i].getVelocity()[d]);
+        }
+    }
+}
+
+TEST(ParticleBatchTest, ChunksCoverRangeOnCacheLines) {
+    WorkerPool pool(4);
+    // Only the address is used; 16 bytes past a cache line, like a heap block
+    const Particle<3> *data = reinterpret_cast<const Particle<3> *>(std::uintptr_t(64 * 1000 + 16));
+    std::vector<int> visits(1000, 0);
+    std::mutex mutex;
+    parallel_for_cache_aligned(pool, data, visits.size(), [&](std::size_t begin, std::size_t end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+        if (begin > 0) {
+            EXPECT_EQ((std::uintptr_t(data) + begin * sizeof(Particle<3>)) % cache_line_bytes, 0u);
+        }
+    });
+    for (int v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+}
+
+// Test the force models against the direct sum
+
+// n particles on a jittered lattice in the unit square or cube
+template <std::size_t N>
+ParticleSystem<N> latticeSystem(std::size_t n) {
+    ParticleSystem<N> system(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t d = 0; d < N; ++d) {
+            system.position(d)[i] = std::fmod(0.618034 * (i + 1) * (d + 1) + 0.1 * std::sin(3.0 * i + d), 1.0);
+        }
+        system.setMass(i, 1.0 + 0.5 * std::cos(double(i)));
+    }
+    return system;
+}
+
+template <std::size_t N>
+void expectForcesNear(ForceModel<N> &model, ForceModel<N> &reference, ParticleSystem<N> &system, double tolerance) {
+    reference.computeForces(system);
+    std::vector<double> expected;
+    for (std::size_t d = 0; d < N; ++d) {
+        expected.insert(expected.end(), system.force(d), system.force(d) + system.size());
+    }
+    model.computeForces(system);
+    for (std::size_t d = 0; d < N; ++d) {
+        for (std::size_t i = 0; i < system.size(); ++i) {
+            EXPECT_NEAR(system.force(d)[i], expected[d * system.size() + i], tolerance);
+        }
+    }
+}
+
+TEST(ForceTest, CellListMatchesDirect) {
+    ParticleSystem<2> system = latticeSystem<2>(500);
+    SoftRepulsion repulsion;
+    repulsion.cutoff = 0.07;
+    CellListForce<2, SoftRepulsion> cells(repulsion);
+    DirectForce<2, SoftRepulsion> direct(repulsion);
+    expectForcesNear(cells, direct, system, 1e-12);
+}
+
+TEST(ForceTest, CellListHandlesExtremePositions) {
+    SoftRepulsion repulsion;
+    repulsion.cutoff = 0.07;
+    CellListForce<2, SoftRepulsion> cells(repulsion);
+
+    // A spread that would need about 1e600 cells of the cutoff size
+    ParticleSystem<2> spread = latticeSystem<2>(10);
+    spread.position(0)[0] = -1e300;
+    spread.position(1)[9] = 1e300;
+    DirectForce<2, SoftRepulsion> direct(repulsion);
+    expectForcesNear(cells, direct, spread, 1e-12);
+
+    ParticleSystem<2> invalid = latticeSystem<2>(10);
+    invalid.position(1)[3] = std::nan("");
+    EXPECT_THROW(cells.computeForces(invalid), std::invalid_argument);
+    invalid.position(1)[3] = HUGE_VAL;
+    EXPECT_THROW(cells.computeForces(invalid), std::invalid_argument);
+    invalid.position(1)[3] = 1.5e308;
+    invalid.position(1)[4] = -1.5e308;
+    EXPECT_THROW(cells.computeForces(invalid), std::invalid_argument);
+}
+
+TEST(ForceTest, BarnesHutWithoutApproximationMatchesDirect) {
+    ParticleSystem<3> system = latticeSystem<3>(300);
+    BarnesHutForce<3> tree(Gravity(), 0.0, 4);
+    DirectForce<3, Gravity> direct;
+    expectForcesNear(tree, direct, system, 1e-6);
+}
+
+TEST(ForceTest, BarnesHutRefitTracksMovingParticles) {
+    ParticleSystem<3> system = latticeSystem<3>(300);
+    BarnesHutForce<3> tree(Gravity(), 0.3, 4, 100); // built once, refitted afterwards
+    DirectForce<3, Gravity> direct;
+    for (int step = 0; step < 5; ++step) {
+        tree.computeForces(system);
+        for (std::size_t i = 0; i < system.size(); ++i) {
+            system.position(0)[i] += 0.05 * std::sin(7.0 * i);
+            system.position(2)[i] -= 0.05 * std::cos(5.0 * i);
+        }
+    }
+    // Relative error of the monopole approximation stays at the percent level
+    direct.computeForces(system);
+    std::vector<double> expected(system.force(1), system.force(1) + system.size());
+    tree.computeForces(system);
+    double error = 0.0, scale = 0.0;
+    for (std::size_t i = 0; i < system.size(); ++i) {
+        error += (system.force(1)[i] - expected[i]) * (system.force(1)[i] - expected[i]);
+        scale += expected[i] * expected[i];
+    }
+    EXPECT_LT(std::sqrt(error / scale), 1e-2);
+}
+
+// Test the integrators on particles in a harmonic trap
+
+// Total energy after the given number of steps, relative to the initial energy
+template <std::size_t N>
+double relativeEnergyDrift(Integrator<N> &integrator, ParticleSystem<N> &system, int steps, double dt) {
+    HarmonicTrap<N> trap;
+    const double initial = kineticEnergy(system) + trap.potentialEnergy(system);
+    for (int step = 0; step < steps; ++step) {
+        integrator.step(system, trap, dt);
+    }
+    integrator.synchronize(system, trap);
+    return std::fabs(kineticEnergy(system) + trap.potentialEnergy(system) - initial) / initial;
+}
+
+TEST(IntegratorTest, VerletKeepsEnergyBounded) {
+    ParticleSystem<2> euler = latticeSystem<2>(50);
+    ParticleSystem<2> verlet = latticeSystem<2>(50);
+    EulerIntegrator<2> eulerStep;
+    VelocityVerlet<2> verletStep;
+    // About 16 periods of the trap
+    EXPECT_GT(relativeEnergyDrift(eulerStep, euler, 1000, 0.1), 1e-2);
+    EXPECT_LT(relativeEnergyDrift(verletStep, verlet, 1000, 0.1), 5e-3);
+}
+
+TEST(IntegratorTest, LeapfrogMatchesVelocityVerlet) {
+    ParticleSystem<3> verlet = latticeSystem<3>(40);
+    ParticleSystem<3> leapfrog = latticeSystem<3>(40);
+    for (std::size_t i = 0; i < verlet.size(); ++i) {
+        verlet.velocity(1)[i] = leapfrog.velocity(1)[i] = 0.1 * std::sin(double(i));
+    }
+    HarmonicTrap<3> trap(2.0);
+    VelocityVerlet<3> verletStep;
+    Leapfrog<3> leapfrogStep;
+    for (int step = 0; step < 100; ++step) {
+        verletStep.step(verlet, trap, 0.05);
+        leapfrogStep.step(leapfrog, trap, 0.05);
+        if (step == 49) {
+            leapfrogStep.synchronize(leapfrog, trap); // and restart mid-run
+        }
+    }
+    leapfrogStep.synchronize(leapfrog, trap);
+    for (std::size_t d = 0; d < 3; ++d) {
+        for (std::size_t i = 0; i < verlet.size(); ++i) {
+            EXPECT_NEAR(leapfrog.position(d)[i], verlet.position(d)[i], 1e-12);
+            EXPECT_NEAR(leapfrog.velocity(d)[i], verlet.velocity(d)[i], 1e-12);
+        }
+    }
+}
+
+// Test the binary trajectory writer and reader
+
+TEST(TrajectoryTest, FramesRoundTrip) {
+    ParticleSystem<3> system = latticeSystem<3>(100);
+    const std::string filename = "test_trajectory.bin";
+    {
+        // Blocks of three frames, so most frames go through the I/O thread before close()
+        TrajectoryWriter<3> writer(filename, system.size(), 3 * 8 * (1 + 3 * 100), 2);
+        ASSERT_TRUE(writer.is_open());
+        for (int frame = 0; frame < 20; ++frame) {
+            writer.append(0.5 * frame, system);
+            system.position(2)[7] += 1.0;
+        }
+        EXPECT_TRUE(writer.close());
+    }
+    MappedTrajectory<3> trajectory;
+    ASSERT_TRUE(trajectory.open(filename));
+    EXPECT_EQ(trajectory.particleCount(), 100u);
+    EXPECT_EQ(trajectory.frameCount(), 20u);
+    EXPECT_EQ(trajectory.time(13), 6.5);
+    EXPECT_EQ(trajectory.position(19, 0)[42], system.position(0)[42]);
+    int visited = 0;
+    trajectory.forEachFrame(5, 8, [&](std::size_t frame, double time, auto position) {
+        EXPECT_EQ(time, 0.5 * frame);
+        EXPECT_DOUBLE_EQ(position(2)[7], system.position(2)[7] - 20.0 + frame);
+        ++visited;
+    });
+    EXPECT_EQ(visited, 3);
+    MappedTrajectory<2> wrongDimensions;
+    EXPECT_FALSE(wrongDimensions.open(filename));
+    std::remove(filename.c_str());
+}
+
+TEST(TrajectoryTest, RejectsParticleCountLargerThanFile) {
+    const std::string filename = "test_trajectory_header.bin";
+    {
+        // A bare header whose particle count makes 8 * (1 + 3 * particles) wrap to 0
+        unsigned char header[trajectoryHeaderSize] = {};
+        const std::uint16_t dimensions = 3;
+        const std::uint64_t particles = ((std::uint64_t(1) << 62) - 1) / 3;
+        std::memcpy(header, trajectoryMagic, 4);
+        std::memcpy(header + 4, &trajectoryVersion, 2);
+        std::memcpy(header + 6, &dimensions, 2);
+        std::memcpy(header + 8, &particles, 8);
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    }
+    MappedTrajectory<3> trajectory;
+    EXPECT_FALSE(trajectory.open(filename));
+    EXPECT_EQ(trajectory.frameCount(), 0u);
+    std::remove(filename.c_str());
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,302 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "particle.h"
+#include "particle_system.h"
+#include "../../common/byte_order.h"
+#include "../../common/mapped_file.h"
+
+// Binary trajectory layout, little-endian:
+//
+//   offset  size  field
+//        0     4  magic "PTRJ"
+//        4     2  format version (1)
+//        6     2  dimensions N
+//        8     8  number of particles n
+//       16     8  number of frames, written on close (0 if the writer did not finish)
+//       24        frames
+//
+// Every frame is the time followed by the positions one component at a time, x[0..n), y[0..n),
+// ..., all float64: 8 * (1 + N * n) bytes. Frames and values stay 8-byte aligned, so a memory
+// mapping is used in place. Values are written in host order, which is why both sides refuse
+// to run on a big-endian host.
+constexpr char trajectoryMagic[4] = {'P', 'T', 'R', 'J'};
+constexpr std::uint16_t trajectoryVersion = 1;
+constexpr std::size_t trajectoryHeaderSize = 24;
+
+// Appends trajectory frames to a file without ever waiting for the disk in the common case.
+//
+// Frames are copied into the current block of a small ring of large blocks; a full block is
+// handed to an I/O thread, which writes it in one call and returns it to the ring. Only when
+// every block is waiting to be written does append() block, so no frame is ever dropped.
+template <std::size_t N>
+class TrajectoryWriter
+{
+public:
+    static constexpr std::size_t defaultBlockBytes = std::size_t(16) << 20;
+
+    // blockBytes is rounded up to hold at least one frame
+    TrajectoryWriter(const std::string &filename, std::size_t particles, std::size_t blockBytes = defaultBlockBytes,
+                     std::size_t blocks = 4)
+        : file_(filename, std::ios::out | std::ios::binary), particles_(particles),
+          frameBytes_(sizeof(double) * (1 + N * particles)),
+          blockBytes_(std::max(blockBytes / frameBytes_, std::size_t(1)) * frameBytes_),
+          blocks_(std::max(blocks, std::size_t(2)))
+    {
+        if (!file_ || !host_is_little_endian()) {
+            std::cerr << "Error opening trajectory file for writing: " << filename << std::endl;
+            file_.close();
+            failed_ = true;
+            return;
+        }
+        writeHeader(0);
+
+        for (std::size_t b = 1; b < blocks_.size(); ++b) {
+            free_.push_back(b);
+        }
+        blocks_[0].resize(blockBytes_);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~TrajectoryWriter() { close(); }
+
+    TrajectoryWriter(const TrajectoryWriter &) = delete;
+    TrajectoryWriter &operator=(const TrajectoryWriter &) = delete;
+
+    bool is_open() const { return thread_.joinable(); }
+    std::uint64_t frameCount() const { return frames_; }
+
+    // Appends the positions of all particles of the system at the given time
+    void append(double time, const ParticleSystem<N> &system)
+    {
+        double *frame = beginFrame(time);
+        if (frame == nullptr) {
+            return;
+        }
+        for (std::size_t d = 0; d < N; ++d) {
+            std::memcpy(frame + d * particles_, system.position(d), particles_ * sizeof(double));
+        }
+    }
+
+    // Appends the positions of the Particle objects at the given time; particles must hold as
+    // many particles as the writer was opened for
+    void append(double time, const Particle<N> *particles)
+    {
+        double *frame = beginFrame(time);
+        if (frame == nullptr) {
+            return;
+        }
+        for (std::size_t i = 0; i < particles_; ++i) {
+            const Vector<N> &position = particles[i].getPosition();
+            for (std::size_t d = 0; d < N; ++d) {
+                frame[d * particles_ + i] = position[d];
+            }
+        }
+    }
+
+    // Writes the remaining frames, stops the I/O thread and records the frame count in the
+    // header. Returns false if anything could not be written.
+    bool close()
+    {
+        if (!thread_.joinable()) {
+            return !failed_;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (used_ > 0) {
+                full_.push_back({current_, used_});
+            }
+            stop_ = true;
+        }
+        changed_.notify_all();
+        thread_.join();
+
+        file_.seekp(0);
+        writeHeader(frames_);
+        file_.close();
+        if (file_.fail()) {
+            failed_ = true;
+        }
+        return !failed_;
+    }
+
+private:
+    struct Filled
+    {
+        std::size_t block;
+        std::size_t bytes;
+    };
+
+    void writeHeader(std::uint64_t frames)
+    {
+        unsigned char header[trajectoryHeaderSize] = {};
+        const std::uint16_t dimensions = N;
+        const std::uint64_t particles = particles_;
+        std::memcpy(header, trajectoryMagic, 4);
+        std::memcpy(header + 4, &trajectoryVersion, 2);
+        std::memcpy(header + 6, &dimensions, 2);
+        std::memcpy(header + 8, &particles, 8);
+        std::memcpy(header + 16, &frames, 8);
+        file_.write(reinterpret_cast<const char *>(header), sizeof(header));
+    }
+
+    // Reserves room for one frame in the current block, stores its time and returns where the
+    // positions go; switches to a free block first if the current one is full
+    double *beginFrame(double time)
+    {
+        if (!thread_.joinable()) {
+            return nullptr;
+        }
+        if (used_ + frameBytes_ > blockBytes_) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            full_.push_back({current_, used_});
+            changed_.notify_all();
+            changed_.wait(lock, [this] { return !free_.empty(); });
+            current_ = free_.front();
+            free_.pop_front();
+            used_ = 0;
+            blocks_[current_].resize(blockBytes_);
+        }
+        double *frame = reinterpret_cast<double *>(blocks_[current_].data() + used_);
+        used_ += frameBytes_;
+        ++frames_;
+        frame[0] = time;
+        return frame + 1;
+    }
+
+    void run()
+    {
+        for (;;) {
+            Filled filled;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                changed_.wait(lock, [this] { return !full_.empty() || stop_; });
+                if (full_.empty()) {
+                    return;
+                }
+                filled = full_.front();
+                full_.pop_front();
+            }
+
+            file_.write(blocks_[filled.block].data(), static_cast<std::streamsize>(filled.bytes));
+            if (!file_) {
+                failed_ = true;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                free_.push_back(filled.block);
+            }
+            changed_.notify_all();
+        }
+    }
+
+    std::ofstream file_;
+    std::size_t particles_;
+    std::size_t frameBytes_;
+    std::size_t blockBytes_;
+    std::vector<std::vector<char>> blocks_;
+    std::size_t current_ = 0; // block being filled by append(), owned by the caller
+    std::size_t used_ = 0;
+    std::uint64_t frames_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::deque<std::size_t> free_;
+    std::deque<Filled> full_;
+    bool stop_ = false;
+    bool failed_ = false;
+    std::thread thread_;
+};
+
+// Read-only view of a trajectory file through a memory mapping. Any range of frames is read in
+// place: only the pages of the frames that are touched are loaded, and nothing is parsed.
+template <std::size_t N>
+class MappedTrajectory
+{
+public:
+    // Maps the file and validates its header. A file whose writer did not finish holds as many
+    // frames as it has complete frames.
+    bool open(const std::string &filename)
+    {
+        particles_ = 0;
+        frames_ = 0;
+        if (!file_.open(filename)) {
+            std::cerr << "Error opening trajectory file: " << filename << std::endl;
+            return false;
+        }
+
+        const char *bytes = file_.data();
+        std::uint16_t version = 0, dimensions = 0;
+        std::uint64_t particles = 0, frames = 0;
+        if (file_.size() < trajectoryHeaderSize || std::memcmp(bytes, trajectoryMagic, 4) != 0 || !host_is_little_endian()) {
+            std::cerr << "Error: Not a trajectory file: " << filename << std::endl;
+            return false;
+        }
+        std::memcpy(&version, bytes + 4, 2);
+        std::memcpy(&dimensions, bytes + 6, 2);
+        std::memcpy(&particles, bytes + 8, 8);
+        std::memcpy(&frames, bytes + 16, 8);
+        if (version != trajectoryVersion || dimensions != N) {
+            std::cerr << "Error: Unsupported version or dimensions in trajectory file: " << filename << std::endl;
+            return false;
+        }
+
+        // The particle count comes from the file: bound it by the file size before it is multiplied
+        if (particles > (file_.size() - trajectoryHeaderSize) / (sizeof(double) * N)) {
+            std::cerr << "Error: Truncated trajectory file: " << filename << std::endl;
+            return false;
+        }
+        const std::uint64_t frameBytes = sizeof(double) * (1 + N * particles);
+        const std::uint64_t complete = (file_.size() - trajectoryHeaderSize) / frameBytes;
+        if (frames > complete) {
+            std::cerr << "Error: Truncated trajectory file: " << filename << std::endl;
+            return false;
+        }
+        particles_ = static_cast<std::size_t>(particles);
+        frames_ = static_cast<std::size_t>(frames > 0 ? frames : complete);
+        return true;
+    }
+
+    std::size_t particleCount() const { return particles_; }
+    std::size_t frameCount() const { return frames_; }
+
+    double time(std::size_t frame) const { return frameData(frame)[0]; }
+
+    // Component d of the positions of all particles in the given frame
+    const double *position(std::size_t frame, std::size_t d) const { return frameData(frame) + 1 + d * particles_; }
+
+    // Calls visit(frame, time, position) for frames [first, last), with position(d) as above
+    template <typename Visit>
+    void forEachFrame(std::size_t first, std::size_t last, Visit &&visit) const
+    {
+        last = std::min(last, frames_);
+        for (std::size_t frame = first; frame < last; ++frame) {
+            visit(frame, time(frame), [this, frame](std::size_t d) { return position(frame, d); });
+        }
+    }
+
+private:
+    const double *frameData(std::size_t frame) const
+    {
+        return reinterpret_cast<const double *>(file_.data() + trajectoryHeaderSize) + frame * (1 + N * particles_);
+    }
+
+    MappedFile file_;
+    std::size_t particles_ = 0;
+    std::size_t frames_ = 0;
+};
+
+#endif // TRAJECTORY_H
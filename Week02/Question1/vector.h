@@ -0,0 +1,346 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include <array>
+#include <cstddef>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <algorithm> // for std::max
+#include <ostream>
+#include <type_traits>
+
+template <std::size_t N>
+class Vector;
+
+// Base of Vector and of the lazy expressions built from it (CRTP). +, - and scalar * on
+// vectors return small expression objects instead of vectors; nothing is computed until the
+// expression is assigned to a Vector, used in a dot product or printed, and then all of it is
+// evaluated in one loop over the components without intermediate vectors.
+template <typename E>
+struct VectorExpression
+{
+    constexpr const E &self() const {
+        return static_cast<const E &>(*this);
+    }
+};
+
+// Expressions hold Vectors by reference and sub-expressions by value, so an expression stays
+// valid as long as the Vectors it refers to
+template <typename E>
+struct ExpressionOperand
+{
+    using type = const E;
+};
+
+template <std::size_t N>
+struct ExpressionOperand<Vector<N>>
+{
+    using type = const Vector<N> &;
+};
+
+struct AddComponents
+{
+    static constexpr double apply(double a, double b) { return a + b; }
+};
+
+struct SubtractComponents
+{
+    static constexpr double apply(double a, double b) { return a - b; }
+};
+
+// Component-wise l op r
+template <typename L, typename R, typename Op>
+class VectorBinaryExpression : public VectorExpression<VectorBinaryExpression<L, R, Op>>
+{
+    static_assert(L::dimension == R::dimension, "Vectors must be of the same size.");
+
+public:
+    static constexpr std::size_t dimension = L::dimension;
+
+    constexpr VectorBinaryExpression(const L &l, const R &r) : l_(l), r_(r) {}
+
+    constexpr double operator[](std::size_t i) const {
+        return Op::apply(l_[i], r_[i]);
+    }
+
+private:
+    typename ExpressionOperand<L>::type l_;
+    typename ExpressionOperand<R>::type r_;
+};
+
+// Component-wise e * scalar
+template <typename E>
+class VectorScaledExpression : public VectorExpression<VectorScaledExpression<E>>
+{
+public:
+    static constexpr std::size_t dimension = E::dimension;
+
+    constexpr VectorScaledExpression(const E &e, double scalar) : e_(e), scalar_(scalar) {}
+
+    constexpr double operator[](std::size_t i) const {
+        return e_[i] * scalar_;
+    }
+
+private:
+    typename ExpressionOperand<E>::type e_;
+    double scalar_;
+};
+
+// Fixed-size vector of N doubles (N = 2 or 3 for particles) stored inline in a std::array,
+// so creating, copying and combining vectors never touches the heap. Operations between
+// vectors of different dimensions do not compile.
+template <std::size_t N>
+class Vector : public VectorExpression<Vector<N>>
+{
+private:
+    std::array<double, N> components_{};
+
+public:
+    // Zero vector
+    constexpr Vector() = default;
+
+    // Constructor from N components, e.g. Vector(x, y) or Vector(x, y, z)
+    template <typename... Components,
+              typename = std::enable_if_t<sizeof...(Components) == N && (std::is_arithmetic_v<Components> && ...)>>
+    constexpr Vector(Components... components) : components_{static_cast<double>(components)...} {}
+
+    // Constructor from an array of components
+    constexpr explicit Vector(const std::array<double, N> &components) : components_(components) {}
+
+    static constexpr std::size_t dimension = N;
+
+    // Number of components
+    static constexpr std::size_t size() {
+        return N;
+    }
+
+    // Unchecked access, for the hot paths
+    constexpr double &operator[](std::size_t i) {
+        return components_[i];
+    }
+
+    constexpr const double &operator[](std::size_t i) const {
+        return components_[i];
+    }
+
+    // Access with bounds checking, for debugging
+    double &at(std::size_t i) {
+        if (i >= N) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return components_[i];
+    }
+
+    const double &at(std::size_t i) const {
+        if (i >= N) {
+            throw std::out_of_range("Index out of bounds.");
+        }
+        return components_[i];
+    }
+
+    // Evaluates an expression such as 2. * v1 + 3. * v2 in a single loop
+    template <typename E>
+    constexpr Vector(const VectorExpression<E> &expression)
+    {
+        static_assert(E::dimension == N, "Vector dimensions must match.");
+        for (std::size_t i = 0; i < N; ++i) {
+            components_[i] = expression.self()[i];
+        }
+    }
+
+    // Component i of the result only depends on component i of the operands, so assigning
+    // an expression that contains this vector (v = v + w) is safe
+    template <typename E>
+    constexpr Vector &operator=(const VectorExpression<E> &expression)
+    {
+        static_assert(E::dimension == N, "Vector dimensions must match.");
+        for (std::size_t i = 0; i < N; ++i) {
+            components_[i] = expression.self()[i];
+        }
+        return *this;
+    }
+
+    // In-place updates
+    template <typename E>
+    constexpr Vector &operator+=(const VectorExpression<E> &expression)
+    {
+        static_assert(E::dimension == N, "Vector dimensions must match.");
+        for (std::size_t i = 0; i < N; ++i) {
+            components_[i] += expression.self()[i];
+        }
+        return *this;
+    }
+
+    template <typename E>
+    constexpr Vector &operator-=(const VectorExpression<E> &expression)
+    {
+        static_assert(E::dimension == N, "Vector dimensions must match.");
+        for (std::size_t i = 0; i < N; ++i) {
+            components_[i] -= expression.self()[i];
+        }
+        return *this;
+    }
+
+    constexpr Vector &operator*=(double scalar)
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            components_[i] *= scalar;
+        }
+        return *this;
+    }
+
+    // Stream output operator
+    friend std::ostream &operator<<(std::ostream &os, const Vector &v)
+    {
+        os << "(";
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            os << v.components_[i];
+            if (i < N - 1)
+                os << ", ";
+        }
+        os << ")";
+        return os;
+    }
+};
+
+// Vector(1.0, 2.0) is a Vector<2>, Vector(1.0, 2.0, 3.0) a Vector<3>
+template <typename... Components, typename = std::enable_if_t<(std::is_arithmetic_v<Components> && ...)>>
+Vector(Components...) -> Vector<sizeof...(Components)>;
+
+// Vector result = v1 + v2 evaluates the expression into a vector of its dimension
+template <typename E>
+Vector(const VectorExpression<E> &) -> Vector<E::dimension>;
+
+// Vector addition
+template <typename L, typename R>
+constexpr VectorBinaryExpression<L, R, AddComponents> operator+(const VectorExpression<L> &l, const VectorExpression<R> &r)
+{
+    return {l.self(), r.self()};
+}
+
+// Vector subtraction
+template <typename L, typename R>
+constexpr VectorBinaryExpression<L, R, SubtractComponents> operator-(const VectorExpression<L> &l, const VectorExpression<R> &r)
+{
+    return {l.self(), r.self()};
+}
+
+// Scalar multiplication, from both sides
+template <typename E>
+constexpr VectorScaledExpression<E> operator*(const VectorExpression<E> &e, double scalar)
+{
+    return {e.self(), scalar};
+}
+
+template <typename E>
+constexpr VectorScaledExpression<E> operator*(double scalar, const VectorExpression<E> &e)
+{
+    return {e.self(), scalar};
+}
+
+// Dot product, fused with the evaluation of both operands
+template <typename L, typename R>
+constexpr double operator*(const VectorExpression<L> &l, const VectorExpression<R> &r)
+{
+    static_assert(L::dimension == R::dimension, "Vectors must be of the same size for dot product.");
+    double dotProduct = 0.0;
+    for (std::size_t i = 0; i < L::dimension; ++i) {
+        dotProduct += l.self()[i] * r.self()[i];
+    }
+    return dotProduct;
+}
+
+// Prints an unevaluated expression by evaluating it first
+template <typename E>
+std::ostream &operator<<(std::ostream &os, const VectorExpression<E> &e)
+{
+    return os << Vector<E::dimension>(e);
+}
+
+using Vec2 = Vector<2>;
+using Vec3 = Vector<3>;
+
+// Norm kinds, selected at compile time: norm<L2Norm>(v). Each folds the components into an
+// accumulator starting at 0 and turns the result into the norm, so the same kind drives the
+// single-vector and the batched versions below.
+struct L1Norm
+{
+    static double accumulate(double sum, double x) { return sum + std::fabs(x); }
+    static double finish(double sum) { return sum; }
+};
+
+struct L2Norm
+{
+    static double accumulate(double sum, double x) { return sum + x * x; }
+    static double finish(double sum) { return std::sqrt(sum); }
+};
+
+// |v|^2, for comparisons and energies where the square root is not needed
+struct SquaredL2Norm
+{
+    static double accumulate(double sum, double x) { return sum + x * x; }
+    static double finish(double sum) { return sum; }
+};
+
+struct LinfNorm
+{
+    static double accumulate(double max, double x) { return std::max(max, std::fabs(x)); }
+    static double finish(double max) { return max; }
+};
+
+// Norm of a vector or of an expression, evaluated in the same loop as the expression
+template <typename Kind, typename E>
+double norm(const VectorExpression<E> &e)
+{
+    double accumulator = 0.0;
+    for (std::size_t i = 0; i < E::dimension; ++i) {
+        accumulator = Kind::accumulate(accumulator, e.self()[i]);
+    }
+    return Kind::finish(accumulator);
+}
+
+// Norms of count vectors at once, out[i] = norm<Kind>(v[i])
+template <typename Kind, std::size_t N>
+void norms(const Vector<N> *v, std::size_t count, double *out)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        double accumulator = 0.0;
+        for (std::size_t d = 0; d < N; ++d) {
+            accumulator = Kind::accumulate(accumulator, v[i][d]);
+        }
+        out[i] = Kind::finish(accumulator);
+    }
+}
+
+// Norms of count vectors stored one component at a time (x[], y[], ...), as in ParticleSystem.
+// One pass reads all N arrays in unit stride and vectorizes.
+template <typename Kind, std::size_t N>
+void norms(const std::array<const double *, N> &components, std::size_t count, double *out)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        double accumulator = 0.0;
+        for (std::size_t d = 0; d < N; ++d) {
+            accumulator = Kind::accumulate(accumulator, components[d][i]);
+        }
+        out[i] = Kind::finish(accumulator);
+    }
+}
+
+// Function to calculate different norms of the vector
+// Supports L1, L2, and Linf norms, named at run time; the hot paths use norm<Kind>
+template <typename E>
+double norm(const VectorExpression<E> &e, const std::string &type)
+{
+    if (type == "L1") {
+        return norm<L1Norm>(e);
+    } else if (type == "L2") {
+        return norm<L2Norm>(e);
+    } else if (type == "Linf") {
+        return norm<LinfNorm>(e);
+    }
+    throw std::invalid_argument("Unknown norm type.");
+}
+
+#endif // VECTOR_H
@@ -1,7 +1,9 @@
-#include "Grid3d_1d_array.h"
+#include "grid3d_1d_array.h"
+#include "grid_kernels.h"
 #include <iostream>
 #include <iomanip>
 #include <stdexcept> // For std::out_of_range and std::invalid_argument
+#include <utility>   // For std::swap
 
 // Constructor
 Grid1::Grid1(int nx_, int ny_, int nz_) : nx(nx_), ny(ny_), nz(nz_) {
@@ -16,6 +18,33 @@ Grid1::~Grid1() {
     delete[] data;
 }
 
+// Move constructor: takes over the storage of other
+Grid1::Grid1(Grid1&& other) noexcept : data(other.data), nx(other.nx), ny(other.ny), nz(other.nz) {
+    other.data = nullptr;
+    other.nx = other.ny = other.nz = 0;
+}
+
+// Move assignment: takes over the storage of other and frees the old one
+Grid1& Grid1::operator=(Grid1&& other) noexcept {
+    if (this != &other) {
+        delete[] data;
+        data = other.data;
+        nx = other.nx;
+        ny = other.ny;
+        nz = other.nz;
+        other.data = nullptr;
+        other.nx = other.ny = other.nz = 0;
+    }
+    return *this;
+}
+
+// Deep copy
+Grid1 Grid1::clone() const {
+    Grid1 copy(nx, ny, nz);
+    gridCopy(data, copy.data, getSize());
+    return copy;
+}
+
 // Get the total number of elements
 int Grid1::getSize() const {
     return nx * ny * nz;
@@ -42,15 +71,21 @@ void Grid1::set(int i, int j, int k, double value) {
     data[i + nx * (j + ny * k)] = value;
 }
 
-// Add two grids element-wise
+// Exchange storage and dimensions with another grid
+void Grid1::swap(Grid1& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(nx, other.nx);
+    std::swap(ny, other.ny);
+    std::swap(nz, other.nz);
+}
+
+// Add two grids element-wise, on all threads of gridPool()
 Grid1 Grid1::operator+(const Grid1& grid) {
     if (nx != grid.nx || ny != grid.ny || nz != grid.nz) {
         throw std::invalid_argument("Grid1::operator+: Grid dimensions do not match");
     }
     Grid1 result(nx, ny, nz);
-    for (int i = 0; i < getSize(); ++i) {
-        result.data[i] = data[i] + grid.data[i];
-    }
+    gridAdd(data, grid.data, result.data, getSize());
     return result;
 }
 
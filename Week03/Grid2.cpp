@@ -2,6 +2,7 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept> // For std::out_of_range and std::invalid_argument
+#include "grid_kernels.h"
 
 // Constructor
 Grid2::Grid2(int nx_, int ny_, int nz_) : nx(nx_), ny(ny_), nz(nz_) {
@@ -42,19 +43,25 @@ void Grid2::set(int i, int j, int k, double value) {
     data[i][j][k] = value;
 }
 
-// Add two grids element-wise
+// Add two grids element-wise. Only the rows along k are contiguous, so the planes i are
+// shared among the threads of gridPool() and each row is added in one vectorized loop.
 Grid2 Grid2::operator+(const Grid2& grid) {
     if (nx != grid.nx || ny != grid.ny || nz != grid.nz) {
         throw std::invalid_argument("Grid2::operator+: Grid dimensions do not match");
     }
     Grid2 result(nx, ny, nz);
-    for (int i = 0; i < nx; ++i) {
-        for (int j = 0; j < ny; ++j) {
-            for (int k = 0; k < nz; ++k) {
-                result.data[i][j][k] = data[i][j][k] + grid.data[i][j][k];
+    gridPool().parallel_for(nx, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (int j = 0; j < ny; ++j) {
+                const double* __restrict a = data[i][j].data();
+                const double* __restrict b = grid.data[i][j].data();
+                double* __restrict out = result.data[i][j].data();
+                for (int k = 0; k < nz; ++k) {
+                    out[k] = a[k] + b[k];
+                }
             }
         }
-    }
+    });
     return result;
 }
 
@@ -2,6 +2,9 @@
 #include <iostream>
 #include <iomanip>
 #include <stdexcept> // For std::out_of_range and std::invalid_argument
+#include <algorithm> // For std::copy
+#include <utility>   // For std::move and std::swap
+#include "grid_kernels.h"
 
 // Constructor
 Grid3::Grid3(int nx_, int ny_, int nz_) : nx(nx_), ny(ny_), nz(nz_) {
@@ -28,6 +31,38 @@ Grid3::~Grid3() {
     delete[] data;
 }
 
+// Move constructor: takes over the rows of other
+Grid3::Grid3(Grid3&& other) noexcept : data(other.data), nx(other.nx), ny(other.ny), nz(other.nz) {
+    other.data = nullptr;
+    other.nx = other.ny = other.nz = 0;
+}
+
+// Move assignment: takes over the rows of other; the old rows go to a temporary and are freed
+Grid3& Grid3::operator=(Grid3&& other) noexcept {
+    Grid3 moved(std::move(other));
+    swap(moved);
+    return *this;
+}
+
+// Deep copy, one row at a time
+Grid3 Grid3::clone() const {
+    Grid3 copy(nx, ny, nz);
+    for (int i = 0; i < nx; ++i) {
+        for (int j = 0; j < ny; ++j) {
+            std::copy(data[i][j], data[i][j] + nz, copy.data[i][j]);
+        }
+    }
+    return copy;
+}
+
+// Exchange storage and dimensions with another grid
+void Grid3::swap(Grid3& other) noexcept {
+    std::swap(data, other.data);
+    std::swap(nx, other.nx);
+    std::swap(ny, other.ny);
+    std::swap(nz, other.nz);
+}
+
 // Get the total number of elements
 int Grid3::getSize() const {
     return nx * ny * nz;
@@ -54,19 +89,25 @@ void Grid3::set(int i, int j, int k, double value) {
     data[i][j][k] = value;
 }
 
-// Add two grids element-wise
+// Add two grids element-wise. Only the rows along k are contiguous, so the planes i are
+// shared among the threads of gridPool() and each row is added in one vectorized loop.
 Grid3 Grid3::operator+(const Grid3& grid) {
     if (nx != grid.nx || ny != grid.ny || nz != grid.nz) {
         throw std::invalid_argument("Grid3::operator+: Grid dimensions do not match");
     }
     Grid3 result(nx, ny, nz);
-    for (int i = 0; i < nx; ++i) {
-        for (int j = 0; j < ny; ++j) {
-            for (int k = 0; k < nz; ++k) {
-                result.data[i][j][k] = data[i][j][k] + grid.data[i][j][k];
+    gridPool().parallel_for(nx, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (int j = 0; j < ny; ++j) {
+                const double* __restrict a = data[i][j];
+                const double* __restrict b = grid.data[i][j];
+                double* __restrict out = result.data[i][j];
+                for (int k = 0; k < nz; ++k) {
+                    out[k] = a[k] + b[k];
+                }
             }
         }
-    }
+    });
     return result;
 }
 
@@ -0,0 +1,351 @@
+/*
+Header-only 3D grid of any element type on the flat Grid1 layout.
+
+Element (i, j, k) is at i + nx * (j + ny * k), so i is the unit-stride index.
+The storage starts on a 64-byte boundary (a cache line, and the widest SIMD
+register), and operator() is unchecked and inlined so that loops over the
+grid compile to the same code as loops over a raw pointer. at() checks the
+indices and is meant for debugging.
+
++, -, scalar * and elementwise * and / on grids build lazy expressions that
+are evaluated in one fused loop when assigned to a grid, so a + b + c makes
+no temporary grids and streams every operand once.
+*/
+#ifndef __GRID_H__
+#define __GRID_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <stdexcept> // For std::out_of_range and std::invalid_argument
+#include <type_traits>
+#include <utility>   // For std::swap
+
+template <typename T>
+class Grid;
+
+// Base of Grid and of the lazy expressions built from it (CRTP). An expression has the
+// dimensions of its operands and computes element n of the flat layout on demand.
+template <typename E>
+struct GridExpression
+{
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// Expressions hold Grids by reference and sub-expressions by value, so an expression stays
+// valid as long as the grids it refers to
+template <typename E>
+struct GridOperand
+{
+    typedef const E type;
+};
+
+template <typename T>
+struct GridOperand<Grid<T> >
+{
+    typedef const Grid<T>& type;
+};
+
+struct AddElements
+{
+    template <typename T>
+    static T apply(T a, T b) { return a + b; }
+};
+
+struct SubtractElements
+{
+    template <typename T>
+    static T apply(T a, T b) { return a - b; }
+};
+
+struct MultiplyElements
+{
+    template <typename T>
+    static T apply(T a, T b) { return a * b; }
+};
+
+struct DivideElements
+{
+    template <typename T>
+    static T apply(T a, T b) { return a / b; }
+};
+
+// Elementwise l op r; the dimensions are checked once, when the expression is built
+template <typename L, typename R, typename Op>
+class GridBinaryExpression : public GridExpression<GridBinaryExpression<L, R, Op> >
+{
+    static_assert(std::is_same<typename L::value_type, typename R::value_type>::value,
+                  "Grid element types must match");
+
+public:
+    typedef typename L::value_type value_type;
+
+    GridBinaryExpression(const L& l_, const R& r_) : l(l_), r(r_) {
+        if (l.getNx() != r.getNx() || l.getNy() != r.getNy() || l.getNz() != r.getNz()) {
+            throw std::invalid_argument("Grid expression: Grid dimensions do not match");
+        }
+    }
+
+    int getNx() const { return l.getNx(); }
+    int getNy() const { return l.getNy(); }
+    int getNz() const { return l.getNz(); }
+    value_type operator[](long n) const { return Op::apply(l[n], r[n]); }
+
+private:
+    typename GridOperand<L>::type l;
+    typename GridOperand<R>::type r;
+};
+
+// Elementwise e * scalar
+template <typename E>
+class GridScaledExpression : public GridExpression<GridScaledExpression<E> >
+{
+public:
+    typedef typename E::value_type value_type;
+
+    GridScaledExpression(const E& e_, value_type scalar_) : e(e_), scalar(scalar_) {}
+
+    int getNx() const { return e.getNx(); }
+    int getNy() const { return e.getNy(); }
+    int getNz() const { return e.getNz(); }
+    value_type operator[](long n) const { return e[n] * scalar; }
+
+private:
+    typename GridOperand<E>::type e;
+    value_type scalar;
+};
+
+template <typename T>
+class Grid : public GridExpression<Grid<T> >
+{
+    static_assert(std::is_arithmetic<T>::value, "Grid elements must be arithmetic types");
+
+public:
+    typedef T value_type;
+    static const std::size_t alignment = 64;
+
+    Grid(int nx_ = 1, int ny_ = 1, int nz_ = 1) : nx(nx_), ny(ny_), nz(nz_) {
+        if (nx <= 0 || ny <= 0 || nz <= 0) {
+            throw std::invalid_argument("Grid::Grid: Dimensions must be positive");
+        }
+        allocate();
+        std::fill(data, data + getSize(), T());
+    }
+
+    Grid(const Grid& other) : nx(other.nx), ny(other.ny), nz(other.nz) {
+        allocate();
+        std::copy(other.data, other.data + getSize(), data);
+    }
+
+    Grid(Grid&& other) noexcept : data(other.data), block(other.block), nx(other.nx), ny(other.ny), nz(other.nz) {
+        other.data = nullptr;
+        other.block = nullptr;
+        other.nx = other.ny = other.nz = 0;
+    }
+
+    // Evaluates an expression such as a + 2.0 * b in a single loop, without zero-filling first
+    template <typename E>
+    Grid(const GridExpression<E>& expression)
+        : nx(expression.self().getNx()), ny(expression.self().getNy()), nz(expression.self().getNz()) {
+        allocate();
+        assign(expression.self());
+    }
+
+    Grid& operator=(Grid other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    // Element n of the result only depends on element n of the operands, so assigning an
+    // expression that contains this grid (a = a + b) is safe. The storage is reused when the
+    // dimensions match.
+    template <typename E>
+    Grid& operator=(const GridExpression<E>& expression) {
+        const E& e = expression.self();
+        if (e.getNx() != nx || e.getNy() != ny || e.getNz() != nz) {
+            Grid result(expression);
+            swap(result);
+            return *this;
+        }
+        assign(e);
+        return *this;
+    }
+
+    // In-place updates, one pass over this grid and the operands
+    template <typename E>
+    Grid& operator+=(const GridExpression<E>& expression) {
+        return update(expression, AddElements());
+    }
+
+    template <typename E>
+    Grid& operator-=(const GridExpression<E>& expression) {
+        return update(expression, SubtractElements());
+    }
+
+    template <typename E>
+    Grid& operator*=(const GridExpression<E>& expression) {
+        return update(expression, MultiplyElements());
+    }
+
+    template <typename E>
+    Grid& operator/=(const GridExpression<E>& expression) {
+        return update(expression, DivideElements());
+    }
+
+    Grid& operator*=(T scalar) {
+        const long size = getSize();
+        for (long n = 0; n < size; ++n) {
+            data[n] *= scalar;
+        }
+        return *this;
+    }
+
+    ~Grid() {
+        ::operator delete(block);
+    }
+
+    int getSize() const { return nx * ny * nz; }
+    std::size_t getMemory() const { return static_cast<std::size_t>(getSize()) * sizeof(T); }
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    int getNz() const { return nz; }
+
+    // Unchecked access, for the hot paths
+    T& operator()(int i, int j, int k) { return data[index(i, j, k)]; }
+    const T& operator()(int i, int j, int k) const { return data[index(i, j, k)]; }
+
+    // Access with bounds checking, for debugging
+    T& at(int i, int j, int k) {
+        check(i, j, k);
+        return data[index(i, j, k)];
+    }
+
+    const T& at(int i, int j, int k) const {
+        check(i, j, k);
+        return data[index(i, j, k)];
+    }
+
+    // Element n of the flat layout, so that a grid is an expression too
+    const T& operator[](long n) const { return data[n]; }
+
+    // The contiguous, 64-byte aligned storage
+    T* getData() { return data; }
+    const T* getData() const { return data; }
+
+    // Exchange storage and dimensions with another grid, e.g. to flip double buffers
+    void swap(Grid& other) noexcept {
+        std::swap(data, other.data);
+        std::swap(block, other.block);
+        std::swap(nx, other.nx);
+        std::swap(ny, other.ny);
+        std::swap(nz, other.nz);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Grid& grid) {
+        for (int k = 0; k < grid.nz; ++k) {
+            for (int j = 0; j < grid.ny; ++j) {
+                for (int i = 0; i < grid.nx; ++i) {
+                    os << std::setw(10) << grid(i, j, k) << " ";
+                }
+                os << std::endl;
+            }
+            os << std::endl;
+        }
+        return os;
+    }
+
+private:
+    template <typename E, typename Op>
+    Grid& update(const GridExpression<E>& expression, Op op) {
+        const E& e = expression.self();
+        if (e.getNx() != nx || e.getNy() != ny || e.getNz() != nz) {
+            throw std::invalid_argument("Grid: Grid dimensions do not match");
+        }
+        evaluate(e, op);
+        return *this;
+    }
+
+    // The loops expressions are evaluated in; the compiler inlines the whole expression into
+    // them and vectorizes them
+    template <typename E>
+    void assign(const E& e) {
+        T* out = data;
+        const long size = getSize();
+        for (long n = 0; n < size; ++n) {
+            out[n] = e[n];
+        }
+    }
+
+    template <typename E, typename Op>
+    void evaluate(const E& e, Op) {
+        T* out = data;
+        const long size = getSize();
+        for (long n = 0; n < size; ++n) {
+            out[n] = Op::apply(out[n], e[n]);
+        }
+    }
+
+    long index(int i, int j, int k) const {
+        return i + static_cast<long>(nx) * (j + static_cast<long>(ny) * k);
+    }
+
+    void check(int i, int j, int k) const {
+        if (i < 0 || i >= nx || j < 0 || j >= ny || k < 0 || k >= nz) {
+            throw std::out_of_range("Grid::at: Index out of bounds");
+        }
+    }
+
+    // Over-allocates by one alignment and starts the elements at the first aligned address
+    void allocate() {
+        block = ::operator new(getMemory() + alignment);
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block);
+        address = (address + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+        data = reinterpret_cast<T*>(address);
+    }
+
+    T* data = nullptr;
+    void* block = nullptr;
+    int nx, ny, nz;
+};
+
+template <typename T>
+void swap(Grid<T>& a, Grid<T>& b) noexcept {
+    a.swap(b);
+}
+
+// Elementwise arithmetic on grids and grid expressions
+template <typename L, typename R>
+GridBinaryExpression<L, R, AddElements> operator+(const GridExpression<L>& l, const GridExpression<R>& r) {
+    return GridBinaryExpression<L, R, AddElements>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+GridBinaryExpression<L, R, SubtractElements> operator-(const GridExpression<L>& l, const GridExpression<R>& r) {
+    return GridBinaryExpression<L, R, SubtractElements>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+GridBinaryExpression<L, R, MultiplyElements> operator*(const GridExpression<L>& l, const GridExpression<R>& r) {
+    return GridBinaryExpression<L, R, MultiplyElements>(l.self(), r.self());
+}
+
+template <typename L, typename R>
+GridBinaryExpression<L, R, DivideElements> operator/(const GridExpression<L>& l, const GridExpression<R>& r) {
+    return GridBinaryExpression<L, R, DivideElements>(l.self(), r.self());
+}
+
+// Scalar multiplication, from both sides
+template <typename E>
+GridScaledExpression<E> operator*(const GridExpression<E>& e, typename E::value_type scalar) {
+    return GridScaledExpression<E>(e.self(), scalar);
+}
+
+template <typename E>
+GridScaledExpression<E> operator*(typename E::value_type scalar, const GridExpression<E>& e) {
+    return GridScaledExpression<E>(e.self(), scalar);
+}
+
+#endif
@@ -16,6 +16,13 @@ class Grid1
 public:
     Grid1(int nx_=1, int ny_=1, int nz_=1);
     ~Grid1();
+    // Grids are not copied implicitly; clone() makes a deep copy where one is wanted.
+    // Moving steals the storage and leaves an empty grid of size 0 behind.
+    Grid1(const Grid1&) = delete;
+    Grid1& operator=(const Grid1&) = delete;
+    Grid1(Grid1&& other) noexcept;
+    Grid1& operator=(Grid1&& other) noexcept;
+    Grid1 clone() const;
     int getSize() const;
     int getMemory() const;
     // Get a value
@@ -26,6 +33,15 @@ public:
     Grid1 operator+(const Grid1& grid);
     friend std::ostream& operator<<(std::ostream& os, const Grid1& grid);
 
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    int getNz() const { return nz; }
+    // Unchecked access to the contiguous storage; element (i, j, k) is at i + nx * (j + ny * k)
+    double* getData() { return data; }
+    const double* getData() const { return data; }
+    // Exchange storage and dimensions with another grid, e.g. to flip double buffers
+    void swap(Grid1& other) noexcept;
+
 
 private:
     double* data;
@@ -17,6 +17,13 @@ class Grid3
 public:
     Grid3(int nx_=1, int ny_=1, int nz_=1);
     ~Grid3();
+    // Grids are not copied implicitly; clone() makes a deep copy where one is wanted.
+    // Moving steals the storage and leaves an empty grid of size 0 behind.
+    Grid3(const Grid3&) = delete;
+    Grid3& operator=(const Grid3&) = delete;
+    Grid3(Grid3&& other) noexcept;
+    Grid3& operator=(Grid3&& other) noexcept;
+    Grid3 clone() const;
     int getSize() const;
     int getMemory() const;
     double operator()(int i, int j, int k) const;
@@ -26,6 +33,12 @@ public:
     Grid3 operator+(const Grid3& grid);
     friend std::ostream& operator<<(std::ostream& os, const Grid3& grid);
 
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    int getNz() const { return nz; }
+    // Exchange storage and dimensions with another grid
+    void swap(Grid3& other) noexcept;
+
 private:
     double*** data;
     int nx, ny, nz;
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include "grid3d_1d_array.h"
+#include "grid.h"
+
+// One 7-point smoothing sweep over the interior, written three ways on the same layout:
+// Grid1's checked, out-of-line accessors, Grid<double>'s unchecked inline operator(), and
+// raw pointers. All three compute the same values.
+void sweep_grid1(const Grid1& in, Grid1& out) {
+    const int nx = in.getNx(), ny = in.getNy(), nz = in.getNz();
+    for (int k = 1; k < nz - 1; ++k) {
+        for (int j = 1; j < ny - 1; ++j) {
+            for (int i = 1; i < nx - 1; ++i) {
+                out.set(i, j, k, 0.4 * in(i, j, k) + 0.1 * (in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) +
+                                                            in(i, j + 1, k) + in(i, j, k - 1) + in(i, j, k + 1)));
+            }
+        }
+    }
+}
+
+void sweep_grid(const Grid<double>& in, Grid<double>& out) {
+    const int nx = in.getNx(), ny = in.getNy(), nz = in.getNz();
+    for (int k = 1; k < nz - 1; ++k) {
+        for (int j = 1; j < ny - 1; ++j) {
+            for (int i = 1; i < nx - 1; ++i) {
+                out(i, j, k) = 0.4 * in(i, j, k) + 0.1 * (in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) +
+                                                          in(i, j + 1, k) + in(i, j, k - 1) + in(i, j, k + 1));
+            }
+        }
+    }
+}
+
+void sweep_raw(const double* in, double* out, int nx, int ny, int nz) {
+    const long plane = static_cast<long>(nx) * ny;
+    for (int k = 1; k < nz - 1; ++k) {
+        for (int j = 1; j < ny - 1; ++j) {
+            const double* c = in + k * plane + static_cast<long>(j) * nx;
+            double* o = out + k * plane + static_cast<long>(j) * nx;
+            for (int i = 1; i < nx - 1; ++i) {
+                o[i] = 0.4 * c[i] + 0.1 * (c[i - 1] + c[i + 1] + c[i - nx] + c[i + nx] + c[i - plane] + c[i + plane]);
+            }
+        }
+    }
+}
+
+// Best time of several calls to sweep, in seconds
+template <typename Sweep>
+double best_time(Sweep sweep) {
+    double best = 1e300;
+    for (int r = 0; r < 5; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        sweep();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = end - start;
+        best = std::min(best, duration.count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [max_n]" << std::endl;
+        return 1;
+    }
+    int max_n = argc == 2 ? std::stoi(argv[1]) : 256;
+    if (max_n < 3) {
+        std::cerr << "Error: max_n must be at least 3." << std::endl;
+        return 1;
+    }
+
+    std::ofstream outfile("grid_benchmark_results.csv");
+    outfile << "n,grid1_s,grid_template_s,raw_pointer_s,grid1_over_raw,grid_template_over_raw" << std::endl;
+    for (int n = 32; n <= max_n; n *= 2) {
+        Grid1 in1(n, n, n), out1(n, n, n);
+        Grid<double> in(n, n, n), out(n, n, n);
+        std::vector<double> rawIn(static_cast<size_t>(n) * n * n), rawOut(rawIn.size());
+        for (int k = 0; k < n; ++k) {
+            for (int j = 0; j < n; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    double value = (37 * i + 11 * j + 5 * k) % 17;
+                    in1.set(i, j, k, value);
+                    in(i, j, k) = value;
+                    rawIn[i + static_cast<size_t>(n) * (j + static_cast<size_t>(n) * k)] = value;
+                }
+            }
+        }
+
+        double grid1Time = best_time([&] { sweep_grid1(in1, out1); });
+        double gridTime = best_time([&] { sweep_grid(in, out); });
+        double rawTime = best_time([&] { sweep_raw(rawIn.data(), rawOut.data(), n, n, n); });
+
+        int c = n / 2;
+        if (out1(c, c, c) != rawOut[c + static_cast<size_t>(n) * (c + static_cast<size_t>(n) * c)] || out(c, c, c) != out1(c, c, c)) {
+            std::cerr << "Error: The sweeps disagree." << std::endl;
+            return 1;
+        }
+
+        std::cout << "Size: " << n << "^3, Grid1: " << grid1Time << " s, Grid<double>: " << gridTime
+                  << " s, raw pointers: " << rawTime << " s (Grid1 " << grid1Time / rawTime << "x, Grid<double> "
+                  << gridTime / rawTime << "x)" << std::endl;
+        outfile << n << "," << grid1Time << "," << gridTime << "," << rawTime << "," << grid1Time / rawTime << ","
+                << gridTime / rawTime << std::endl;
+    }
+    outfile.close();
+    std::cout << "Results saved to grid_benchmark_results.csv" << std::endl;
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include "grid3d_1d_array.h"
+#include "grid.h"
+#include "grid_kernels.h"
+
+// Best time of several calls to run, in seconds
+template <typename Run>
+double best_time(Run run) {
+    double best = 1e300;
+    for (int r = 0; r < 5; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        run();
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = end - start;
+        best = std::min(best, duration.count());
+    }
+    return best;
+}
+
+// a + b + c on n^3 grids: Grid1::operator+, which allocates and zero-fills a temporary per
+// operator, against the fused Grid<double> expressions. Bytes moved are the compulsory
+// traffic of each form: Grid1 zero-fills, reads two operands and writes the result twice.
+int main(int argc, char* argv[]) {
+    if (argc > 2) {
+        std::cerr << "Usage: " << argv[0] << " [n]" << std::endl;
+        return 1;
+    }
+    int n = argc == 2 ? std::stoi(argv[1]) : 256;
+    if (n <= 0) {
+        std::cerr << "Error: n must be a positive integer." << std::endl;
+        return 1;
+    }
+    const double points = static_cast<double>(n) * n * n;
+
+    Grid1 a1(n, n, n), b1(n, n, n), c1(n, n, n);
+    Grid<double> a(n, n, n), b(n, n, n), c(n, n, n), d(n, n, n);
+    for (int k = 0; k < n; ++k) {
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i < n; ++i) {
+                double value = (37 * i + 11 * j + 5 * k) % 17;
+                a1.set(i, j, k, value);
+                b1.set(i, j, k, 2.0 * value);
+                c1.set(i, j, k, 0.5);
+                a(i, j, k) = value;
+                b(i, j, k) = 2.0 * value;
+                c(i, j, k) = 0.5;
+            }
+        }
+    }
+
+    double check1 = 0.0, check = 0.0;
+    double grid1Time = best_time([&] {
+        Grid1 sum = a1 + b1 + c1;
+        check1 = sum(n / 2, n / 2, n / 2);
+    });
+    double newTime = best_time([&] {
+        Grid<double> sum = a + b + c;
+        check = sum(n / 2, n / 2, n / 2);
+    });
+    double assignTime = best_time([&] { d = a + b + c; });
+    if (check1 != check || d(n / 2, n / 2, n / 2) != check) {
+        std::cerr << "Error: Grid1 and Grid<double> disagree." << std::endl;
+        return 1;
+    }
+    double compoundTime = best_time([&] { d += a + b; });
+
+    // Grid1::operator+ runs on all threads of gridPool(), the expressions on one, so the speedup
+    // of an expression over Grid1 is per core only when both thread counts are 1
+    const unsigned grid1Threads = gridPool().size();
+    const struct {
+        const char* name;
+        const char* key;
+        double seconds;
+        double doublesPerPoint;
+        unsigned threads;
+    } results[] = {
+        {"Grid1 sum = a + b + c", "grid1_operator_plus", grid1Time, 8.0, grid1Threads},
+        {"Grid<double> sum = a + b + c", "expression_new_grid", newTime, 4.0, 1},
+        {"d = a + b + c", "expression_assign", assignTime, 4.0, 1},
+        {"d += a + b", "expression_compound", compoundTime, 4.0, 1},
+    };
+
+    std::ofstream outfile("grid_expression_benchmark_results.csv");
+    outfile << "n,method,threads,time_s,bytes_moved,bandwidth_GBs,speedup" << std::endl;
+    for (const auto& result : results) {
+        double bytes = result.doublesPerPoint * sizeof(double) * points;
+        std::cout << result.name << " (" << result.threads << (result.threads == 1 ? " thread" : " threads") << "): "
+                  << result.seconds << " s, " << bytes / 1e6 << " MB moved, " << bytes / result.seconds / 1e9
+                  << " GB/s (" << grid1Time / result.seconds << "x)" << std::endl;
+        outfile << n << "," << result.key << "," << result.threads << "," << result.seconds << "," << bytes << ","
+                << bytes / result.seconds / 1e9 << "," << grid1Time / result.seconds << std::endl;
+    }
+    outfile.close();
+    std::cout << "Results saved to grid_expression_benchmark_results.csv" << std::endl;
+    return 0;
+}
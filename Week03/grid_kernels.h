@@ -0,0 +1,276 @@
+/*
+Parallel elementwise kernels and reductions over the flat storage of a grid.
+
+Every kernel splits [0, n) into one contiguous range per worker of a
+WorkerPool, with the boundaries on cache lines of the array that is written,
+and runs a plain unit-stride loop over restrict pointers on each range so
+that the compiler vectorizes it. The reductions keep several partial results
+per range so that they vectorize as well, and combine the ranges in order,
+so a given number of threads always gives the same result.
+
+The overloads taking grids work for Grid1 and Grid<T>; the grids must have
+the same dimensions.
+*/
+#ifndef __GRID_KERNELS_H__
+#define __GRID_KERNELS_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <stdexcept> // For std::invalid_argument
+#include <string>
+#include <utility>
+#include <vector>
+#include "../common/worker_pool.h"
+
+// Pool the kernels run on when none is given: all hardware threads, started on first use
+inline WorkerPool& gridPool() {
+    static WorkerPool pool;
+    return pool;
+}
+
+// out = a + b
+template <typename T>
+void gridAdd(const T* a, const T* b, T* out, std::size_t n, WorkerPool& pool = gridPool()) {
+    parallel_for_cache_aligned(pool, out, n, [=](std::size_t begin, std::size_t end) {
+        const T* __restrict pa = a;
+        const T* __restrict pb = b;
+        T* __restrict po = out;
+        for (std::size_t i = begin; i < end; ++i) {
+            po[i] = pa[i] + pb[i];
+        }
+    });
+}
+
+// y += alpha * x
+template <typename T>
+void gridAxpy(T alpha, const T* x, T* y, std::size_t n, WorkerPool& pool = gridPool()) {
+    parallel_for_cache_aligned(pool, y, n, [=](std::size_t begin, std::size_t end) {
+        const T* __restrict px = x;
+        T* __restrict py = y;
+        for (std::size_t i = begin; i < end; ++i) {
+            py[i] += alpha * px[i];
+        }
+    });
+}
+
+// x *= alpha
+template <typename T>
+void gridScale(T alpha, T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    parallel_for_cache_aligned(pool, x, n, [=](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            x[i] *= alpha;
+        }
+    });
+}
+
+template <typename T>
+void gridFill(T* x, std::size_t n, T value, WorkerPool& pool = gridPool()) {
+    parallel_for_cache_aligned(pool, x, n, [=](std::size_t begin, std::size_t end) {
+        std::fill(x + begin, x + end, value);
+    });
+}
+
+// y = x
+template <typename T>
+void gridCopy(const T* x, T* y, std::size_t n, WorkerPool& pool = gridPool()) {
+    parallel_for_cache_aligned(pool, y, n, [=](std::size_t begin, std::size_t end) {
+        std::copy(x + begin, x + end, y + begin);
+    });
+}
+
+// Reductions: fold() adds one element to a partial result, combine() merges two partials
+template <typename T>
+struct SumReduction
+{
+    typedef T result_type;
+    static T identity() { return T(); }
+    static T fold(T sum, T x) { return sum + x; }
+    static T combine(T a, T b) { return a + b; }
+};
+
+template <typename T>
+struct MinReduction
+{
+    typedef T result_type;
+    static T identity() { return std::numeric_limits<T>::max(); }
+    static T fold(T m, T x) { return x < m ? x : m; }
+    static T combine(T a, T b) { return fold(a, b); }
+};
+
+template <typename T>
+struct MaxReduction
+{
+    typedef T result_type;
+    static T identity() { return std::numeric_limits<T>::lowest(); }
+    static T fold(T m, T x) { return x > m ? x : m; }
+    static T combine(T a, T b) { return fold(a, b); }
+};
+
+template <typename T>
+struct AbsSumReduction
+{
+    typedef double result_type;
+    static double identity() { return 0.0; }
+    static double fold(double sum, T x) { return sum + std::abs(static_cast<double>(x)); }
+    static double combine(double a, double b) { return a + b; }
+};
+
+template <typename T>
+struct SquareSumReduction
+{
+    typedef double result_type;
+    static double identity() { return 0.0; }
+    static double fold(double sum, T x) { return sum + static_cast<double>(x) * static_cast<double>(x); }
+    static double combine(double a, double b) { return a + b; }
+};
+
+template <typename T>
+struct AbsMaxReduction
+{
+    typedef double result_type;
+    static double identity() { return 0.0; }
+    static double fold(double m, T x) {
+        const double a = std::abs(static_cast<double>(x));
+        return a > m ? a : m;
+    }
+    static double combine(double a, double b) { return a > b ? a : b; }
+};
+
+template <typename Reduction, typename T>
+typename Reduction::result_type gridReduce(const T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    typedef typename Reduction::result_type R;
+    const std::size_t lanes = 8;
+
+    std::mutex mutex;
+    std::vector<std::pair<std::size_t, R>> partials;
+    parallel_for_cache_aligned(pool, x, n, [&](std::size_t begin, std::size_t end) {
+        R lane[lanes];
+        std::fill(lane, lane + lanes, Reduction::identity());
+        std::size_t i = begin;
+        for (; i + lanes <= end; i += lanes) {
+            for (std::size_t l = 0; l < lanes; ++l) {
+                lane[l] = Reduction::fold(lane[l], x[i + l]);
+            }
+        }
+        for (; i < end; ++i) {
+            lane[0] = Reduction::fold(lane[0], x[i]);
+        }
+        R partial = lane[0];
+        for (std::size_t l = 1; l < lanes; ++l) {
+            partial = Reduction::combine(partial, lane[l]);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        partials.push_back(std::make_pair(begin, partial));
+    });
+
+    std::sort(partials.begin(), partials.end(),
+              [](const std::pair<std::size_t, R>& a, const std::pair<std::size_t, R>& b) { return a.first < b.first; });
+    R result = Reduction::identity();
+    for (const auto& partial : partials) {
+        result = Reduction::combine(result, partial.second);
+    }
+    return result;
+}
+
+template <typename T>
+T gridSum(const T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    return gridReduce<SumReduction<T>>(x, n, pool);
+}
+
+template <typename T>
+T gridMin(const T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    return gridReduce<MinReduction<T>>(x, n, pool);
+}
+
+template <typename T>
+T gridMax(const T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    return gridReduce<MaxReduction<T>>(x, n, pool);
+}
+
+template <typename T>
+double gridNormL1(const T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    return gridReduce<AbsSumReduction<T>>(x, n, pool);
+}
+
+template <typename T>
+double gridNormL2(const T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    return std::sqrt(gridReduce<SquareSumReduction<T>>(x, n, pool));
+}
+
+template <typename T>
+double gridNormLinf(const T* x, std::size_t n, WorkerPool& pool = gridPool()) {
+    return gridReduce<AbsMaxReduction<T>>(x, n, pool);
+}
+
+// The same kernels on whole grids
+
+template <typename G>
+void checkSameDimensions(const G& a, const G& b, const char* what) {
+    if (a.getNx() != b.getNx() || a.getNy() != b.getNy() || a.getNz() != b.getNz()) {
+        throw std::invalid_argument(std::string(what) + ": Grid dimensions do not match");
+    }
+}
+
+template <typename G>
+void gridAdd(const G& a, const G& b, G& out, WorkerPool& pool = gridPool()) {
+    checkSameDimensions(a, b, "gridAdd");
+    checkSameDimensions(a, out, "gridAdd");
+    gridAdd(a.getData(), b.getData(), out.getData(), a.getSize(), pool);
+}
+
+template <typename G, typename T>
+void gridAxpy(T alpha, const G& x, G& y, WorkerPool& pool = gridPool()) {
+    checkSameDimensions(x, y, "gridAxpy");
+    gridAxpy(alpha, x.getData(), y.getData(), x.getSize(), pool);
+}
+
+template <typename G, typename T>
+void gridScale(T alpha, G& x, WorkerPool& pool = gridPool()) {
+    gridScale(alpha, x.getData(), x.getSize(), pool);
+}
+
+template <typename G, typename T>
+void gridFill(G& x, T value, WorkerPool& pool = gridPool()) {
+    gridFill(x.getData(), x.getSize(), value, pool);
+}
+
+template <typename G>
+void gridCopy(const G& x, G& y, WorkerPool& pool = gridPool()) {
+    checkSameDimensions(x, y, "gridCopy");
+    gridCopy(x.getData(), y.getData(), x.getSize(), pool);
+}
+
+template <typename G>
+auto gridSum(const G& x, WorkerPool& pool = gridPool()) -> decltype(gridSum(x.getData(), 0, pool)) {
+    return gridSum(x.getData(), x.getSize(), pool);
+}
+
+template <typename G>
+auto gridMin(const G& x, WorkerPool& pool = gridPool()) -> decltype(gridMin(x.getData(), 0, pool)) {
+    return gridMin(x.getData(), x.getSize(), pool);
+}
+
+template <typename G>
+auto gridMax(const G& x, WorkerPool& pool = gridPool()) -> decltype(gridMax(x.getData(), 0, pool)) {
+    return gridMax(x.getData(), x.getSize(), pool);
+}
+
+template <typename G>
+double gridNormL1(const G& x, WorkerPool& pool = gridPool()) {
+    return gridNormL1(x.getData(), x.getSize(), pool);
+}
+
+template <typename G>
+double gridNormL2(const G& x, WorkerPool& pool = gridPool()) {
+    return gridNormL2(x.getData(), x.getSize(), pool);
+}
+
+template <typename G>
+double gridNormLinf(const G& x, WorkerPool& pool = gridPool()) {
+    return gridNormLinf(x.getData(), x.getSize(), pool);
+}
+
+#endif
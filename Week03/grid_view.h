@@ -0,0 +1,239 @@
+/*
+Non-owning view of a box of points in a grid with the flat Grid1 layout.
+
+A view stores a pointer to its first element, its dimensions and the distance
+in elements between neighbours along i, j and k, so sub-blocks, strided slices
+and the halo layers around an interior are all views into the same storage
+and nothing is copied. GridView<double> writes into the grid,
+GridView<const double> only reads it. A view does not keep its grid alive.
+
+Views work on Grid1 and Grid<T>. Grid2 and Grid3 store separately allocated
+rows that no single set of strides can describe.
+*/
+#ifndef __GRID_VIEW_H__
+#define __GRID_VIEW_H__
+
+#include <algorithm> // For std::copy
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept> // For std::out_of_range and std::invalid_argument
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "grid_kernels.h"
+
+template <typename T>
+class GridView;
+
+// True for views, so that the constructor from a whole grid never takes a view
+template <typename G>
+struct IsGridView : std::false_type {};
+
+template <typename T>
+struct IsGridView<GridView<T> > : std::true_type {};
+
+template <typename T>
+class GridView
+{
+public:
+    typedef typename std::remove_const<T>::type value_type;
+
+    GridView(T* data_, int nx_, int ny_, int nz_, long si_, long sj_, long sk_)
+        : data(data_), nx(nx_), ny(ny_), nz(nz_), si(si_), sj(sj_), sk(sk_) {
+        if (nx < 0 || ny < 0 || nz < 0) {
+            throw std::invalid_argument("GridView::GridView: Dimensions must not be negative");
+        }
+    }
+
+    // The whole of a Grid1 or Grid<T>. Views are copied and converted by the constructors
+    // below, which keep their strides.
+    template <typename G, typename = typename std::enable_if<!IsGridView<typename std::remove_const<G>::type>::value>::type>
+    explicit GridView(G& grid)
+        : GridView(grid.getData(), grid.getNx(), grid.getNy(), grid.getNz(),
+                   1, grid.getNx(), static_cast<long>(grid.getNx()) * grid.getNy()) {}
+
+    // A writable view converts to a read-only one
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    GridView(const GridView<U>& other)
+        : GridView(other.getData(), other.getNx(), other.getNy(), other.getNz(),
+                   other.getStrideI(), other.getStrideJ(), other.getStrideK()) {}
+
+    int getNx() const { return nx; }
+    int getNy() const { return ny; }
+    int getNz() const { return nz; }
+    long getSize() const { return static_cast<long>(nx) * ny * nz; }
+    long getStrideI() const { return si; }
+    long getStrideJ() const { return sj; }
+    long getStrideK() const { return sk; }
+    T* getData() const { return data; }
+
+    // Unchecked access, for the hot paths
+    T& operator()(int i, int j, int k) const { return data[i * si + j * sj + k * sk]; }
+
+    // Access with bounds checking, for debugging
+    T& at(int i, int j, int k) const {
+        if (i < 0 || i >= nx || j < 0 || j >= ny || k < 0 || k >= nz) {
+            throw std::out_of_range("GridView::at: Index out of bounds");
+        }
+        return (*this)(i, j, k);
+    }
+
+    // The nx_ x ny_ x nz_ box starting at (i0, j0, k0)
+    GridView block(int i0, int j0, int k0, int nx_, int ny_, int nz_) const {
+        if (i0 < 0 || j0 < 0 || k0 < 0 || nx_ < 0 || ny_ < 0 || nz_ < 0 ||
+            i0 + nx_ > nx || j0 + ny_ > ny || k0 + nz_ > nz) {
+            throw std::out_of_range("GridView::block: Block exceeds the view");
+        }
+        return GridView(data + i0 * si + j0 * sj + k0 * sk, nx_, ny_, nz_, si, sj, sk);
+    }
+
+    // Every step_i-th point along i, step_j-th along j and step_k-th along k, starting at 0
+    GridView strided(int step_i, int step_j, int step_k) const {
+        if (step_i <= 0 || step_j <= 0 || step_k <= 0) {
+            throw std::invalid_argument("GridView::strided: Steps must be positive");
+        }
+        return GridView(data, (nx + step_i - 1) / step_i, (ny + step_j - 1) / step_j, (nz + step_k - 1) / step_k,
+                        si * step_i, sj * step_j, sk * step_k);
+    }
+
+    // The plane at index n along axis (0 = i, 1 = j, 2 = k), as a view of thickness 1
+    GridView slice(int axis, int n) const {
+        return layer(axis, n, 1);
+    }
+
+    // Everything but a halo of width points on every face
+    GridView interior(int width) const {
+        if (width < 0 || 2 * width > nx || 2 * width > ny || 2 * width > nz) {
+            throw std::invalid_argument("GridView::interior: Halo is wider than the view");
+        }
+        return block(width, width, width, nx - 2 * width, ny - 2 * width, nz - 2 * width);
+    }
+
+    // The halo layer of width points on one face: axis 0 = i, 1 = j, 2 = k; side 0 = low, 1 = high.
+    // The layers span the whole view, so the layers of different axes overlap at edges and corners.
+    GridView halo(int axis, int side, int width) const {
+        if (side != 0 && side != 1) {
+            throw std::invalid_argument("GridView::halo: Side must be 0 or 1");
+        }
+        const int n = axis == 0 ? nx : axis == 1 ? ny : nz;
+        return layer(axis, side == 0 ? 0 : n - width, width);
+    }
+
+    // Sets every point of the view, sharing the planes k among the threads of pool
+    void fill(value_type value, WorkerPool& pool = gridPool()) const {
+        forEachRow(pool, [=](T* row, std::size_t) {
+            for (int i = 0; i < nx; ++i) {
+                row[i * si] = value;
+            }
+        });
+    }
+
+    // Copies a view of the same dimensions into this one. The rows are copied in parallel in no
+    // particular order, so the two views must not share points: a source that overlaps this
+    // view, such as the same block shifted by one point, is rejected. Views whose rows merely
+    // interleave in memory, such as two planes i of a grid, are fine.
+    void assign(const GridView<const value_type>& source, WorkerPool& pool = gridPool()) const {
+        if (source.getNx() != nx || source.getNy() != ny || source.getNz() != nz) {
+            throw std::invalid_argument("GridView::assign: View dimensions do not match");
+        }
+        if (overlaps(source)) {
+            throw std::invalid_argument("GridView::assign: Views overlap");
+        }
+        forEachRow(pool, [&](T* row, std::size_t n) {
+            const value_type* in = source.getData() + static_cast<long>(n % ny) * source.getStrideJ() +
+                                     static_cast<long>(n / ny) * source.getStrideK();
+            if (si == 1 && source.getStrideI() == 1) {
+                std::copy(in, in + nx, row);
+                return;
+            }
+            for (int i = 0; i < nx; ++i) {
+                row[i * si] = in[i * source.getStrideI()];
+            }
+        });
+    }
+
+    value_type sum() const {
+        value_type total = value_type();
+        for (int k = 0; k < nz; ++k) {
+            for (int j = 0; j < ny; ++j) {
+                const T* row = data + j * sj + k * sk;
+                for (int i = 0; i < nx; ++i) {
+                    total += row[i * si];
+                }
+            }
+        }
+        return total;
+    }
+
+private:
+    typedef std::pair<std::uintptr_t, std::uintptr_t> AddressRange;
+
+    // First and last byte address of every row along i, sorted
+    template <typename U>
+    static std::vector<AddressRange> rowRanges(const GridView<U>& view) {
+        std::vector<AddressRange> rows;
+        rows.reserve(static_cast<std::size_t>(view.getNy()) * view.getNz());
+        for (int k = 0; k < view.getNz(); ++k) {
+            for (int j = 0; j < view.getNy(); ++j) {
+                const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(&view(0, j, k));
+                const std::uintptr_t last = reinterpret_cast<std::uintptr_t>(&view(view.getNx() - 1, j, k));
+                rows.push_back(AddressRange(first, last + sizeof(U) - 1));
+            }
+        }
+        std::sort(rows.begin(), rows.end());
+        return rows;
+    }
+
+    // Whether a row of this view and a row of other share memory. Exact for unit-stride rows;
+    // rows with a stride along i count as their whole range.
+    template <typename U>
+    bool overlaps(const GridView<U>& other) const {
+        if (getSize() == 0 || other.getSize() == 0) {
+            return false;
+        }
+        const std::vector<AddressRange> rows = rowRanges(*this);
+        const std::vector<AddressRange> otherRows = rowRanges(other);
+        std::size_t a = 0, b = 0;
+        while (a < rows.size() && b < otherRows.size()) {
+            if (rows[a].second < otherRows[b].first) {
+                ++a;
+            } else if (otherRows[b].second < rows[a].first) {
+                ++b;
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    GridView layer(int axis, int first, int width) const {
+        if (axis == 0) {
+            return block(first, 0, 0, width, ny, nz);
+        } else if (axis == 1) {
+            return block(0, first, 0, nx, width, nz);
+        } else if (axis == 2) {
+            return block(0, 0, first, nx, ny, width);
+        }
+        throw std::invalid_argument("GridView: Axis must be 0, 1 or 2");
+    }
+
+    // Runs row(pointer to (0, j, k), j + ny * k) for every row along i of the view
+    template <typename Row>
+    void forEachRow(WorkerPool& pool, Row row) const {
+        const std::size_t rows = static_cast<std::size_t>(ny) * nz;
+        if (rows == 0 || nx == 0) {
+            return;
+        }
+        pool.parallel_for(rows, ny, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t n = begin; n < end; ++n) {
+                row(data + static_cast<long>(n % ny) * sj + static_cast<long>(n / ny) * sk, n);
+            }
+        });
+    }
+
+    T* data;
+    int nx, ny, nz;
+    long si, sj, sk;
+};
+
+#endif
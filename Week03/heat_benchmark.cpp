@@ -0,0 +1,88 @@
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <algorithm>
+#include "grid3d_1d_array.h"
+#include "heat_diffusion3d.h"
+
+// STREAM-style triad a = b + s * c on arrays far larger than the caches, split over num_threads.
+// Returns the best bandwidth in GB/s over several repetitions, counting 3 * 8 bytes per element
+// as STREAM does.
+double measure_stream_triad(int num_threads) {
+    const size_t n = size_t(1) << 25; // 32M doubles, 256 MB per array
+    std::vector<double> a(n, 0.0), b(n, 1.0), c(n, 2.0);
+    double best = 0.0;
+    for (int r = 0; r < 5; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> pool;
+        for (int t = 0; t < num_threads; ++t) {
+            pool.emplace_back([&, t] {
+                size_t begin = n * t / num_threads, end = n * (t + 1) / num_threads;
+                for (size_t i = begin; i < end; ++i) {
+                    a[i] = b[i] + 3.0 * c[i];
+                }
+            });
+        }
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> duration = end - start;
+        best = std::max(best, 3.0 * sizeof(double) * n / duration.count() / 1e9);
+    }
+    return best;
+}
+
+// Times heatDiffuse on an n^3 grid and returns the seconds per step
+double measure_heat_step(int n, int steps, int num_threads) {
+    Grid1 grid(n, n, n);
+    double* data = grid.getData();
+    for (long i = 0; i < static_cast<long>(grid.getSize()); ++i) {
+        data[i] = static_cast<double>(i % 97);
+    }
+
+    HeatSweepOptions options;
+    options.numThreads = num_threads;
+    heatDiffuse(grid, 0.1, 1, options); // warm up: page in both buffers
+    auto start = std::chrono::high_resolution_clock::now();
+    heatDiffuse(grid, 0.1, steps, options);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> duration = end - start;
+    return duration.count() / steps;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " [num_threads] [steps]" << std::endl;
+        return 1;
+    }
+    int num_threads = argc >= 2 ? std::stoi(argv[1]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int steps = argc == 3 ? std::stoi(argv[2]) : 10;
+    if (num_threads <= 0 || steps <= 0) {
+        std::cerr << "Error: The number of threads and steps must be positive integers." << std::endl;
+        return 1;
+    }
+
+    double peak = measure_stream_triad(num_threads);
+    std::cout << "STREAM triad with " << num_threads << " threads: " << peak << " GB/s" << std::endl;
+
+    std::ofstream outfile("heat_benchmark_results.csv");
+    outfile << "n,threads,steps,time_per_step,points_per_s,bandwidth_GBs,stream_triad_GBs,fraction_of_peak" << std::endl;
+    std::vector<int> sizes = {128, 256, 384, 512};
+    for (int n : sizes) {
+        double time = measure_heat_step(n, steps, num_threads);
+        double points = static_cast<double>(n) * n * n;
+        // Compulsory traffic per step: every point read once and written once
+        double bandwidth = 2.0 * sizeof(double) * points / time / 1e9;
+        std::cout << "Size: " << n << "^3, Time per step: " << time << " s, Bandwidth: " << bandwidth
+                  << " GB/s (" << 100.0 * bandwidth / peak << "% of triad)" << std::endl;
+        outfile << n << "," << num_threads << "," << steps << "," << time << "," << points / time << ","
+                << bandwidth << "," << peak << "," << bandwidth / peak << std::endl;
+    }
+    outfile.close();
+    std::cout << "Results saved to heat_benchmark_results.csv" << std::endl;
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "heat_diffusion3d.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdexcept> // For std::invalid_argument
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Rows are plain unit-stride loops over restrict pointers so that the compiler vectorizes them along i
+void diffuseRow5(const double* __restrict c, const double* __restrict jm, const double* __restrict jp,
+                 double* __restrict out, int nx, double alpha, double centre) {
+    for (int i = 1; i < nx - 1; ++i) {
+        out[i] = centre * c[i] + alpha * (c[i - 1] + c[i + 1] + jm[i] + jp[i]);
+    }
+}
+
+void diffuseRow7(const double* __restrict c, const double* __restrict jm, const double* __restrict jp,
+                 const double* __restrict km, const double* __restrict kp,
+                 double* __restrict out, int nx, double alpha, double centre) {
+    for (int i = 1; i < nx - 1; ++i) {
+        out[i] = centre * c[i] + alpha * (c[i - 1] + c[i + 1] + jm[i] + jp[i] + km[i] + kp[i]);
+    }
+}
+
+// Steps the interior rows of in whose outer index (j in 2D, k in 3D) is in [begin, end)
+void sweep(const double* in, double* out, int nx, int ny, int nz, double alpha, int tileJ, int begin, int end) {
+    const long plane = static_cast<long>(nx) * ny;
+    if (nz == 1) {
+        const double centre = 1.0 - 4.0 * alpha;
+        for (int j = begin; j < end; ++j) {
+            const double* c = in + static_cast<long>(j) * nx;
+            diffuseRow5(c, c - nx, c + nx, out + static_cast<long>(j) * nx, nx, alpha, centre);
+        }
+        return;
+    }
+
+    // Tiling over j keeps the three planes of a tile in cache while k advances
+    const double centre = 1.0 - 6.0 * alpha;
+    for (int jt = 1; jt < ny - 1; jt += tileJ) {
+        const int jEnd = std::min(jt + tileJ, ny - 1);
+        for (int k = begin; k < end; ++k) {
+            for (int j = jt; j < jEnd; ++j) {
+                const long offset = static_cast<long>(k) * plane + static_cast<long>(j) * nx;
+                const double* c = in + offset;
+                diffuseRow7(c, c - nx, c + nx, c - plane, c + plane, out + offset, nx, alpha, centre);
+            }
+        }
+    }
+}
+
+int resolveThreads(int numThreads, int rows) {
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    return std::max(1, std::min(numThreads, rows));
+}
+
+// Reusable barrier for the threads of one heatDiffuse call
+class StepBarrier {
+public:
+    explicit StepBarrier(int count) : count(count) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        int phase = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            ++generation;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [&] { return generation != phase; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    int count;
+    int waiting = 0;
+    int generation = 0;
+};
+
+} // namespace
+
+double maxStableAlpha(const Grid1& grid) {
+    return grid.getNz() == 1 ? 0.25 : 1.0 / 6.0;
+}
+
+void heatStep(const Grid1& in, Grid1& out, double alpha, const HeatSweepOptions& options) {
+    if (in.getNx() != out.getNx() || in.getNy() != out.getNy() || in.getNz() != out.getNz()) {
+        throw std::invalid_argument("heatStep: Grid dimensions do not match");
+    }
+    const int nx = in.getNx(), ny = in.getNy(), nz = in.getNz();
+    const int outer = nz == 1 ? ny : nz;
+    if (nx < 3 || ny < 3 || (nz != 1 && nz < 3)) {
+        return;
+    }
+
+    const int rows = outer - 2;
+    const int threads = resolveThreads(options.numThreads, rows);
+    const int tileJ = std::max(options.tileJ, 1);
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(sweep, in.getData(), out.getData(), nx, ny, nz, alpha, tileJ,
+                          1 + rows * t / threads, 1 + rows * (t + 1) / threads);
+    }
+    sweep(in.getData(), out.getData(), nx, ny, nz, alpha, tileJ, 1, 1 + rows / threads);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+void heatDiffuse(Grid1& grid, double alpha, int steps, const HeatSweepOptions& options) {
+    const int nx = grid.getNx(), ny = grid.getNy(), nz = grid.getNz();
+    if (steps <= 0 || nx < 3 || ny < 3 || (nz != 1 && nz < 3)) {
+        return;
+    }
+
+    // The boundary is never written, so the second buffer starts as a full copy
+    Grid1 next(nx, ny, nz);
+    std::memcpy(next.getData(), grid.getData(), sizeof(double) * grid.getSize());
+
+    const int rows = (nz == 1 ? ny : nz) - 2;
+    const int threads = resolveThreads(options.numThreads, rows);
+    const int tileJ = std::max(options.tileJ, 1);
+    double* buffers[2] = {grid.getData(), next.getData()};
+    StepBarrier barrier(threads);
+
+    auto worker = [&](int t) {
+        const int begin = 1 + rows * t / threads;
+        const int end = 1 + rows * (t + 1) / threads;
+        for (int s = 0; s < steps; ++s) {
+            sweep(buffers[s & 1], buffers[(s + 1) & 1], nx, ny, nz, alpha, tileJ, begin, end);
+            if (threads > 1) {
+                barrier.wait();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    // After an odd number of steps the result is in the second buffer
+    if (steps & 1) {
+        grid.swap(next);
+    }
+}
@@ -0,0 +1,29 @@
+/*
+Explicit heat diffusion on the flat Grid1 layout.
+
+A grid with nz == 1 is treated as 2D and stepped with the 5-point stencil,
+otherwise the 7-point stencil is used. Boundary points are held fixed.
+*/
+#ifndef __HEAT_DIFFUSION3D_H__
+#define __HEAT_DIFFUSION3D_H__
+
+#include "grid3d_1d_array.h"
+
+struct HeatSweepOptions
+{
+    int numThreads = 1; // threads sharing each sweep; 0 uses all hardware threads
+    int tileJ = 16;     // rows of j per tile in 3D, so the k-1, k, k+1 planes of a tile stay in cache
+};
+
+// Largest alpha = dt / dx^2 for which the explicit scheme is stable: 1/4 in 2D, 1/6 in 3D
+double maxStableAlpha(const Grid1& grid);
+
+// One explicit step from in to out. Only the interior of out is written; in and out must have
+// the same dimensions and must not be the same grid.
+void heatStep(const Grid1& in, Grid1& out, double alpha, const HeatSweepOptions& options = HeatSweepOptions());
+
+// Advance grid by the given number of steps. A second grid is allocated once and the two are
+// used as double buffers; the threads are started once and synchronize between steps.
+void heatDiffuse(Grid1& grid, double alpha, int steps, const HeatSweepOptions& options = HeatSweepOptions());
+
+#endif
@@ -1,8 +1,17 @@
 #include <iostream>
 #include <cassert>
+#include <cmath>
 #include "grid3d_1d_array.h"
 #include "grid3d_new.h"
 #include "grid3d_vector.h"
+#include "heat_diffusion3d.h"
+#include "grid.h"
+#include "grid_kernels.h"
+#include "grid_view.h"
+#include <cstdint>
+#include <utility>
+#include <thread>
+#include <vector>
 using namespace std;
 
 void test_grid1_size() {
@@ -78,6 +87,352 @@ void test_grid1_out_of_bounds() {
     }
 }
 
+// Reference 7-point (or 5-point when nz == 1) step through the checked accessors
+void reference_heat_step(const Grid1& in, Grid1& out, double alpha) {
+    int nx = in.getNx(), ny = in.getNy(), nz = in.getNz();
+    for (int k = 0; k < nz; k++) {
+        for (int j = 0; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                bool boundary = i == 0 || i == nx - 1 || j == 0 || j == ny - 1 || (nz > 1 && (k == 0 || k == nz - 1));
+                double c = in(i, j, k);
+                if (boundary) {
+                    out.set(i, j, k, c);
+                    continue;
+                }
+                double sum = in(i - 1, j, k) + in(i + 1, j, k) + in(i, j - 1, k) + in(i, j + 1, k);
+                double neighbours = 4;
+                if (nz > 1) {
+                    sum += in(i, j, k - 1) + in(i, j, k + 1);
+                    neighbours = 6;
+                }
+                out.set(i, j, k, (1.0 - neighbours * alpha) * c + alpha * sum);
+            }
+        }
+    }
+}
+
+void test_heat_diffusion() {
+    cout << "Running test_heat_diffusion..." << endl;
+    const int dims[][3] = {{9, 7, 1}, {6, 11, 5}, {17, 5, 9}};
+    for (const auto& d : dims) {
+        int nx = d[0], ny = d[1], nz = d[2];
+        Grid1 expected(nx, ny, nz), scratch(nx, ny, nz), grid(nx, ny, nz), threaded(nx, ny, nz);
+        for (int i = 0; i < nx; i++) {
+            for (int j = 0; j < ny; j++) {
+                for (int k = 0; k < nz; k++) {
+                    double value = (37 * i + 11 * j + 5 * k) % 17;
+                    expected.set(i, j, k, value);
+                    grid.set(i, j, k, value);
+                    threaded.set(i, j, k, value);
+                }
+            }
+        }
+        double alpha = 0.9 * maxStableAlpha(grid);
+        int steps = 5;
+        for (int s = 0; s < steps; s++) {
+            reference_heat_step(expected, scratch, alpha);
+            expected.swap(scratch);
+        }
+
+        HeatSweepOptions options;
+        options.tileJ = 2;
+        heatDiffuse(grid, alpha, steps, options);
+        options.numThreads = 3;
+        heatDiffuse(threaded, alpha, steps, options);
+        for (int i = 0; i < nx; i++) {
+            for (int j = 0; j < ny; j++) {
+                for (int k = 0; k < nz; k++) {
+                    assert(std::abs(grid(i, j, k) - expected(i, j, k)) < 1e-12);
+                    assert(threaded(i, j, k) == grid(i, j, k));
+                }
+            }
+        }
+    }
+    cout << "Heat diffusion test passed." << endl;
+}
+
+// Layout, alignment, checked access and copies of Grid<T> for one element type
+template <typename T>
+void check_grid_template() {
+    int nx = 5, ny = 3, nz = 4;
+    Grid<T> grid(nx, ny, nz);
+    assert(grid.getSize() == nx * ny * nz);
+    assert(grid.getMemory() == static_cast<size_t>(nx * ny * nz) * sizeof(T));
+    assert(reinterpret_cast<std::uintptr_t>(grid.getData()) % Grid<T>::alignment == 0);
+    for (int i = 0; i < nx; i++) {
+        for (int j = 0; j < ny; j++) {
+            for (int k = 0; k < nz; k++) {
+                assert(grid(i, j, k) == T());
+                grid(i, j, k) = static_cast<T>(100 * i + 10 * j + k);
+            }
+        }
+    }
+    assert(grid.getData()[2 + nx * (1 + ny * 3)] == static_cast<T>(213));
+    assert(grid.at(4, 2, 3) == static_cast<T>(423));
+    try {
+        grid.at(nx, 0, 0);
+        assert(false); // Should not reach here
+    } catch (const std::out_of_range&) {
+    }
+
+    Grid<T> copy(grid);
+    copy(0, 0, 0) = static_cast<T>(7);
+    assert(grid(0, 0, 0) == T());
+    const T* storage = copy.getData();
+    Grid<T> moved(std::move(copy));
+    assert(moved.getData() == storage && moved(0, 0, 0) == static_cast<T>(7));
+}
+
+void test_grid_template() {
+    cout << "Running test_grid_template..." << endl;
+    check_grid_template<float>();
+    check_grid_template<double>();
+    check_grid_template<int>();
+    cout << "Grid<T> test passed." << endl;
+}
+
+void test_grid_expressions() {
+    cout << "Running test_grid_expressions..." << endl;
+    int nx = 7, ny = 3, nz = 2;
+    Grid<double> a(nx, ny, nz), b(nx, ny, nz), c(nx, ny, nz);
+    for (int n = 0; n < a.getSize(); n++) {
+        a.getData()[n] = n;
+        b.getData()[n] = 2.0 + n % 5;
+        c.getData()[n] = 0.5 * n;
+    }
+
+    Grid<double> sum = a + b + c;
+    Grid<double> mixed = 2.0 * a - b * c / b;
+    Grid<double> compound(a);
+    compound += b * c;
+    compound -= 0.5 * a;
+    compound *= 2.0;
+    for (int n = 0; n < a.getSize(); n++) {
+        assert(sum.getData()[n] == a[n] + b[n] + c[n]);
+        assert(std::abs(mixed.getData()[n] - (2.0 * a[n] - c[n])) < 1e-12);
+        assert(compound.getData()[n] == 2.0 * (a[n] + b[n] * c[n] - 0.5 * a[n]));
+    }
+
+    // Assigning an expression that reads the target, and into a grid of other dimensions
+    const double* storage = sum.getData();
+    sum = sum - a;
+    assert(sum.getData() == storage && sum(3, 2, 1) == b(3, 2, 1) + c(3, 2, 1));
+    Grid<double> other;
+    other = a * 3.0;
+    assert(other.getNx() == nx && other(6, 2, 1) == 3.0 * a(6, 2, 1));
+
+    Grid<int> counts(2, 2, 2);
+    counts(1, 1, 1) = 7;
+    Grid<int> doubled = counts + counts;
+    assert(doubled(1, 1, 1) == 14 && doubled(0, 0, 0) == 0);
+
+    try {
+        Grid<double> wrong = a + Grid<double>(nx, ny, nz + 1);
+        assert(false); // Should not reach here
+    } catch (const std::invalid_argument&) {
+    }
+    cout << "Grid expression test passed." << endl;
+}
+
+void test_grid_kernels() {
+    cout << "Running test_grid_kernels..." << endl;
+    // Odd sizes, so that the ranges of the workers do not end on cache lines
+    int nx = 37, ny = 11, nz = 5;
+    Grid<double> x(nx, ny, nz), y(nx, ny, nz), z(nx, ny, nz);
+    for (int n = 0; n < x.getSize(); n++) {
+        x.getData()[n] = n % 13 - 6.0;
+        y.getData()[n] = 0.25 * n;
+    }
+
+    double sum = 0.0, l1 = 0.0, l2 = 0.0, linf = 0.0, lo = x[0], hi = x[0];
+    for (int n = 0; n < x.getSize(); n++) {
+        sum += x[n];
+        l1 += std::abs(x[n]);
+        l2 += x[n] * x[n];
+        linf = std::max(linf, std::abs(x[n]));
+        lo = std::min(lo, x[n]);
+        hi = std::max(hi, x[n]);
+    }
+
+    for (unsigned threads = 1; threads <= 3; threads++) {
+        WorkerPool pool(threads);
+        gridAdd(x, y, z, pool);
+        for (int n = 0; n < x.getSize(); n++) {
+            assert(z[n] == x[n] + y[n]);
+        }
+        gridAxpy(-1.0, y, z, pool);
+        gridScale(2.0, z, pool);
+        for (int n = 0; n < x.getSize(); n++) {
+            assert(z[n] == 2.0 * x[n]);
+        }
+        gridCopy(x, z, pool);
+        assert(z(36, 10, 4) == x(36, 10, 4));
+        gridFill(z, 3.0, pool);
+        assert(z[0] == 3.0 && z(36, 10, 4) == 3.0);
+
+        assert(gridSum(x, pool) == sum);
+        assert(gridMin(x, pool) == lo && gridMax(x, pool) == hi);
+        assert(gridNormL1(x, pool) == l1 && gridNormLinf(x, pool) == linf);
+        assert(std::abs(gridNormL2(x, pool) - std::sqrt(l2)) < 1e-12);
+    }
+
+    // Grid1 and Grid3 operator+ run on the pool as well
+    Grid1 a(nx, ny, nz);
+    Grid3 b(nx, ny, nz);
+    a.set(36, 10, 4, 1.5);
+    b.set(36, 10, 4, 1.5);
+    assert((a + a)(36, 10, 4) == 3.0 && (b + b)(36, 10, 4) == 3.0);
+    assert(gridSum(a) == 1.5);
+
+    try {
+        Grid<double> wrong(nx, ny, nz + 1);
+        gridCopy(x, wrong);
+        assert(false); // Should not reach here
+    } catch (const std::invalid_argument&) {
+    }
+    cout << "Grid kernel test passed." << endl;
+}
+
+void test_grid_concurrent_pool() {
+    cout << "Running test_grid_concurrent_pool..." << endl;
+    // Two threads adding on the shared pool, and on an explicit pool with more workers than
+    // this host may have, must each get all of their own result
+    int nx = 64, ny = 32, nz = 16;
+    Grid1 a(nx, ny, nz), b(nx, ny, nz);
+    gridFill(a, 1.0);
+    gridFill(b, 2.0);
+    WorkerPool pool(4);
+    bool correct[2] = {true, true};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; t++) {
+        threads.emplace_back([&, t] {
+            for (int repeat = 0; repeat < 50; repeat++) {
+                Grid1 sum = t == 0 ? a + b : b + a;
+                Grid1 other(nx, ny, nz);
+                gridAdd(a, sum, other, pool);
+                correct[t] = correct[t] && gridMin(sum) == 3.0 && gridMax(sum) == 3.0 &&
+                             gridMin(other, pool) == 4.0 && gridMax(other, pool) == 4.0;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(correct[0] && correct[1]);
+    cout << "Grid concurrent pool test passed." << endl;
+}
+
+void test_grid_moves() {
+    cout << "Running test_grid_moves..." << endl;
+    Grid1 a(4, 3, 2);
+    a.set(3, 2, 1, 5.0);
+    const double* storage = a.getData();
+
+    // Moving steals the buffer and leaves an empty grid behind
+    Grid1 b(std::move(a));
+    assert(b.getData() == storage && b(3, 2, 1) == 5.0);
+    assert(a.getData() == nullptr && a.getSize() == 0);
+    Grid1 c;
+    c = std::move(b);
+    assert(c.getData() == storage && b.getSize() == 0);
+
+    // clone() is a deep copy
+    Grid1 d = c.clone();
+    assert(d.getData() != c.getData() && d(3, 2, 1) == 5.0);
+    d.set(3, 2, 1, 1.0);
+    assert(c(3, 2, 1) == 5.0);
+
+    Grid3 e(4, 3, 2);
+    e.set(3, 2, 1, 7.0);
+    Grid3 f = e.clone();
+    Grid3 g(std::move(e));
+    assert(e.getSize() == 0 && g(3, 2, 1) == 7.0);
+    g.set(3, 2, 1, 1.0);
+    assert(f(3, 2, 1) == 7.0);
+    f = std::move(g);
+    assert(f(3, 2, 1) == 1.0 && f.getNx() == 4);
+    Grid3 sum = f + f;
+    assert(sum(3, 2, 1) == 2.0);
+    cout << "Grid move test passed." << endl;
+}
+
+void test_grid_view() {
+    cout << "Running test_grid_view..." << endl;
+    int nx = 6, ny = 5, nz = 4;
+    Grid1 grid(nx, ny, nz);
+    GridView<double> all(grid);
+    assert(all.getSize() == grid.getSize() && &all(5, 4, 3) == grid.getData() + grid.getSize() - 1);
+
+    // Writing through a sub-block changes exactly the points of the block
+    GridView<double> box = all.block(1, 2, 1, 3, 2, 2);
+    box.fill(1.0);
+    assert(all.sum() == 12.0 && grid(1, 2, 1) == 1.0 && grid(3, 3, 2) == 1.0 && grid(4, 3, 2) == 0.0);
+    assert(box(0, 0, 0) == grid(1, 2, 1));
+
+    // Interior and halo layers with width 1
+    gridFill(grid, 0.0);
+    all.interior(1).fill(1.0);
+    assert(all.sum() == (nx - 2) * (ny - 2) * (nz - 2));
+    for (int axis = 0; axis < 3; axis++) {
+        for (int side = 0; side < 2; side++) {
+            assert(all.halo(axis, side, 1).sum() == 0.0);
+        }
+    }
+    all.halo(2, 1, 1).fill(2.0);
+    assert(grid(0, 0, nz - 1) == 2.0 && grid(nx - 2, ny - 2, nz - 2) == 1.0);
+
+    // Strided slices, and copying between views of the same shape
+    Grid<double> coarse(3, 3, 2);
+    GridView<const double> fine = GridView<double>(grid).strided(2, 2, 2);
+    assert(fine.getNx() == 3 && fine.getNy() == 3 && fine.getNz() == 2);
+    GridView<double>(coarse).assign(fine);
+    assert(coarse(1, 1, 0) == grid(2, 2, 0) && coarse(2, 2, 1) == grid(4, 4, 2));
+    GridView<double> plane = all.slice(0, 3);
+    plane.assign(all.slice(0, 1));
+    assert(plane.getNx() == 1 && grid(3, 2, 1) == grid(1, 2, 1));
+
+    // Copies and read-only conversions of sub-views keep their strides
+    for (int n = 0; n < grid.getSize(); n++) {
+        grid.getData()[n] = n;
+    }
+    GridView<double> inner = all.block(1, 1, 1, 4, 3, 2);
+    GridView<double> innerCopy(inner);
+    GridView<const double> innerRead(inner);
+    assert(innerCopy.getStrideJ() == nx && innerCopy.getStrideK() == nx * ny);
+    assert(innerRead.getStrideJ() == nx && innerRead.getStrideK() == nx * ny);
+    assert(innerCopy(3, 2, 1) == grid(4, 3, 2) && innerRead(3, 2, 1) == grid(4, 3, 2));
+    GridView<double> every = all.strided(2, 2, 3);
+    GridView<double> everyCopy(every);
+    GridView<const double> everyRead(every);
+    assert(everyCopy.getStrideI() == 2 && everyCopy.getStrideJ() == 2 * nx && everyCopy.getStrideK() == 3 * nx * ny);
+    assert(everyRead.getStrideK() == 3 * nx * ny && everyRead(2, 2, 1) == grid(4, 4, 3));
+    assert(everyCopy(1, 1, 1) == grid(2, 2, 3));
+
+    try {
+        all.block(4, 0, 0, 3, 1, 1);
+        assert(false); // Should not reach here
+    } catch (const std::out_of_range&) {
+    }
+    try {
+        GridView<double>(coarse).assign(all);
+        assert(false); // Should not reach here
+    } catch (const std::invalid_argument&) {
+    }
+
+    // Shifting a block by one point inside the same grid would read points it already wrote
+    const double before = grid(2, 1, 1);
+    try {
+        all.block(1, 1, 1, 3, 3, 2).assign(all.block(0, 1, 1, 3, 3, 2));
+        assert(false); // Should not reach here
+    } catch (const std::invalid_argument&) {
+    }
+    assert(grid(2, 1, 1) == before);
+    // Disjoint blocks of the same grid are fine
+    all.block(3, 0, 0, 3, 5, 4).assign(all.block(0, 0, 0, 3, 5, 4));
+    assert(grid(5, 4, 3) == grid(2, 4, 3));
+    cout << "Grid view test passed." << endl;
+}
+
 int main()
 {
     cout << "Starting tests..." << endl;
@@ -86,6 +441,13 @@ int main()
     test_grid2_addition();
     test_grid3_memory();
     test_grid1_out_of_bounds();
+    test_heat_diffusion();
+    test_grid_template();
+    test_grid_expressions();
+    test_grid_kernels();
+    test_grid_concurrent_pool();
+    test_grid_moves();
+    test_grid_view();
     cout << "All tests passed." << endl;
     return 0;
 }
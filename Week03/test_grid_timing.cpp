@@ -3,9 +3,12 @@
 #include <vector>
 #include <numeric>
 #include <fstream>
+#include <algorithm>
+#include <thread>
 #include "grid3d_1d_array.h"
 #include "grid3d_vector.h"
 #include "grid3d_new.h"
+#include "grid_kernels.h"
 
 double measure_execution_time(int n) {
     Grid1 grid(n, n, n);
@@ -45,9 +48,55 @@ void execute_timings() {
     outfile.close();
 }
 
+// Best time of repeats calls to run, in seconds
+template <typename Run>
+double best_time(Run run, int repeats) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        run();
+        auto end = std::chrono::high_resolution_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+// Memory bandwidth of the elementwise kernels on an n^3 grid for 1, 2, 4, ... threads, up to
+// twice the hardware threads. Bytes are the compulsory traffic: add reads two grids and writes
+// one, axpy reads two and writes one, sum reads one.
+void execute_bandwidth(int n) {
+    Grid1 a(n, n, n), b(n, n, n), c(n, n, n);
+    gridFill(a, 1.0);
+    gridFill(b, 2.0);
+    const double bytes = static_cast<double>(a.getSize()) * sizeof(double);
+    const unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    const int repeats = 5;
+
+    std::ofstream outfile("bandwidth_results.txt");
+    outfile << "threads add_GBps axpy_GBps sum_GBps" << std::endl;
+    for (unsigned threads = 1; threads <= 2 * hardware; threads *= 2) {
+        WorkerPool pool(threads);
+        double addTime = best_time([&] { gridAdd(a, b, c, pool); }, repeats);
+        double axpyTime = best_time([&] { gridAxpy(0.5, a, c, pool); }, repeats);
+        double sum = 0.0;
+        double sumTime = best_time([&] { sum += gridSum(c, pool); }, repeats);
+        if (!(sum > 0.0)) {
+            std::cerr << "gridSum returned " << sum << std::endl;
+        }
+
+        double addRate = 3 * bytes / addTime / 1e9;
+        double axpyRate = 3 * bytes / axpyTime / 1e9;
+        double sumRate = bytes / sumTime / 1e9;
+        std::cout << "Threads: " << threads << ", add: " << addRate << " GB/s, axpy: " << axpyRate
+                  << " GB/s, sum: " << sumRate << " GB/s" << std::endl;
+        outfile << threads << " " << addRate << " " << axpyRate << " " << sumRate << std::endl;
+    }
+}
+
 int main() {
     std::cout << "Program started." << std::endl;
     execute_timings();
+    execute_bandwidth(200);
     std::cout << "Program finished." << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#ifndef BUFFERED_TEXT_WRITER_H
+#define BUFFERED_TEXT_WRITER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Text file writer that formats numbers with std::to_chars into a large buffer.
+ *
+ * Floating-point values are written in their shortest round-trip form, independent of the
+ * locale, and the file is only written to when the buffer is full, on flush() or on close().
+ * Supports the subset of operator<< used by the writers in this repository: arithmetic
+ * values, characters and strings. There are no manipulators; '\n' never flushes.
+ */
+class BufferedTextWriter
+{
+public:
+    static constexpr std::size_t default_buffer_bytes = 1 << 20;
+
+    /**
+     * Opens the file for writing.
+     *
+     * @param filename The name of the file to write to.
+     * @param mode Open mode passed on to std::ofstream, e.g. std::ios::app to append.
+     * @param buffer_bytes The size of the output buffer in bytes.
+     */
+    explicit BufferedTextWriter(const std::string& filename, std::ios::openmode mode = std::ios::out,
+                                std::size_t buffer_bytes = default_buffer_bytes)
+        : file_(filename, mode | std::ios::out), buffer_(std::max<std::size_t>(buffer_bytes, max_number_chars))
+    {
+    }
+
+    ~BufferedTextWriter()
+    {
+        flush();
+    }
+
+    BufferedTextWriter(const BufferedTextWriter&) = delete;
+    BufferedTextWriter& operator=(const BufferedTextWriter&) = delete;
+
+    bool is_open() const { return file_.is_open(); }
+
+    // True once a write to the file has failed. Call close() or flush() first to include buffered data.
+    bool fail() const { return file_.fail(); }
+
+    void flush()
+    {
+        if (pos_ > 0)
+        {
+            file_.write(buffer_.data(), static_cast<std::streamsize>(pos_));
+            pos_ = 0;
+        }
+    }
+
+    void close()
+    {
+        flush();
+        file_.close();
+    }
+
+    template <typename T,
+              typename = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>>>
+    BufferedTextWriter& operator<<(T value)
+    {
+        if (buffer_.size() - pos_ < max_number_chars)
+        {
+            flush();
+        }
+        auto result = std::to_chars(buffer_.data() + pos_, buffer_.data() + buffer_.size(), value);
+        pos_ = static_cast<std::size_t>(result.ptr - buffer_.data());
+        return *this;
+    }
+
+    BufferedTextWriter& operator<<(char c)
+    {
+        if (pos_ == buffer_.size())
+        {
+            flush();
+        }
+        buffer_[pos_++] = c;
+        return *this;
+    }
+
+    BufferedTextWriter& operator<<(const char* s)
+    {
+        return append(s, std::strlen(s));
+    }
+
+    BufferedTextWriter& operator<<(const std::string& s)
+    {
+        return append(s.data(), s.size());
+    }
+
+private:
+    // Longest shortest-round-trip double is 24 characters ("-1.7976931348623157e+308")
+    static constexpr std::size_t max_number_chars = 32;
+
+    BufferedTextWriter& append(const char* s, std::size_t n)
+    {
+        if (buffer_.size() - pos_ < n)
+        {
+            flush();
+            if (n > buffer_.size())
+            {
+                file_.write(s, static_cast<std::streamsize>(n));
+                return *this;
+            }
+        }
+        std::memcpy(buffer_.data() + pos_, s, n);
+        pos_ += n;
+        return *this;
+    }
+
+    std::ofstream file_;
+    std::vector<char> buffer_;
+    std::size_t pos_ = 0;
+};
+
+#endif // BUFFERED_TEXT_WRITER_H
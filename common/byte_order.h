@@ -0,0 +1,17 @@
+#ifndef BYTE_ORDER_H
+#define BYTE_ORDER_H
+
+#include <cstdint>
+#include <cstring>
+
+// True on hosts that store the least significant byte first, as all binary file formats of
+// the course do
+inline bool host_is_little_endian()
+{
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+#endif // BYTE_ORDER_H
@@ -0,0 +1,161 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The mapping is released when the object goes out of scope. An empty file is
+ * reported as open with size() == 0 and data() == nullptr, since neither mmap
+ * nor MapViewOfFile can map zero bytes.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+
+    explicit MappedFile(const std::string& filename)
+    {
+        open(filename);
+    }
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * Maps the given file into memory, releasing any previous mapping.
+     *
+     * @param filename The name of the file to map.
+     * @return true if the file could be opened and mapped.
+     */
+    bool open(const std::string& filename)
+    {
+        close();
+#ifdef _WIN32
+        file_ = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file_, &file_size))
+        {
+            close();
+            return false;
+        }
+        size_ = static_cast<std::size_t>(file_size.QuadPart);
+        if (size_ > 0)
+        {
+            mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping_ == nullptr)
+            {
+                close();
+                return false;
+            }
+            data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+            if (data_ == nullptr)
+            {
+                close();
+                return false;
+            }
+        }
+#else
+        fd_ = ::open(filename.c_str(), O_RDONLY);
+        if (fd_ < 0)
+        {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd_, &st) != 0)
+        {
+            close();
+            return false;
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0)
+        {
+            void* addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (addr == MAP_FAILED)
+            {
+                close();
+                return false;
+            }
+            madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(addr);
+        }
+#endif
+        open_ = true;
+        return true;
+    }
+
+    // Releases the mapping and the underlying file handle
+    void close()
+    {
+#ifdef _WIN32
+        if (data_ != nullptr)
+        {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr)
+        {
+            CloseHandle(mapping_);
+        }
+        if (file_ != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file_);
+        }
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_ != nullptr)
+        {
+            munmap(const_cast<char*>(data_), size_);
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+        open_ = false;
+    }
+
+    bool is_open() const { return open_; }
+    const char* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool open_ = false;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+#endif // MAPPED_FILE_H
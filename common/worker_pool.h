@@ -0,0 +1,203 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+constexpr std::size_t cache_line_bytes = 64;
+
+/**
+ * Fixed set of threads that is started once and reused for every parallel step.
+ *
+ * run() hands the same task to all workers and returns when every one has finished; the calling
+ * thread takes part as worker 0, so a pool of size 1 runs the task inline without any threads.
+ * Idle workers block on a condition variable, so a pool costs nothing between steps.
+ *
+ * Several threads may share one pool: their calls to run() take turns, each one running on all
+ * workers. A task must not call run() or parallel_for() on the pool it runs on, which would wait
+ * for itself forever.
+ */
+class WorkerPool
+{
+public:
+    /**
+     * Starts the worker threads.
+     *
+     * @param num_threads The number of workers including the calling thread; 0 uses all hardware threads.
+     */
+    explicit WorkerPool(unsigned num_threads = 0)
+        : size_(num_threads > 0 ? num_threads : std::max(1u, std::thread::hardware_concurrency()))
+    {
+        threads_.reserve(size_ - 1);
+        for (unsigned worker = 1; worker < size_; ++worker)
+        {
+            threads_.emplace_back([this, worker] { work(worker); });
+        }
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Number of workers, including the calling thread
+    unsigned size() const { return size_; }
+
+    /**
+     * Runs task(worker) on every worker, worker = 0 .. size() - 1, and waits for all of them.
+     *
+     * @param task The work of one worker; must not call run() on the same pool.
+     */
+    void run(const std::function<void(unsigned)>& task)
+    {
+        if (size_ == 1)
+        {
+            task(0);
+            return;
+        }
+
+        // One task at a time: a second caller would overwrite task_ and pending_
+        std::lock_guard<std::mutex> turn(run_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            pending_ = size_ - 1;
+            ++generation_;
+        }
+        start_.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        task_ = nullptr;
+    }
+
+    /**
+     * Splits [0, count) into one contiguous range per worker and runs body(begin, end) on each.
+     * Every boundary between ranges is a multiple of granularity, so that neighbouring workers
+     * never write to the same cache line when granularity elements fill whole lines.
+     *
+     * @param count The number of elements.
+     * @param granularity Range boundaries are multiples of this many elements.
+     * @param body Called with the half-open range [begin, end) of one worker; may be empty.
+     * @param first_boundary The first multiple; boundaries are first_boundary + k * granularity.
+     */
+    template <typename Body>
+    void parallel_for(std::size_t count, std::size_t granularity, Body&& body, std::size_t first_boundary = 0)
+    {
+        granularity = std::max<std::size_t>(granularity, 1);
+        first_boundary = std::min(first_boundary, count);
+        const std::size_t blocks = (count - first_boundary + granularity - 1) / granularity;
+        const unsigned workers = size_;
+        run([&](unsigned worker) {
+            auto boundary = [&](unsigned w) {
+                if (w == 0)
+                {
+                    return std::size_t(0);
+                }
+                if (w == workers)
+                {
+                    return count;
+                }
+                return std::min(count, first_boundary + blocks * w / workers * granularity);
+            };
+            const std::size_t begin = boundary(worker);
+            const std::size_t end = boundary(worker + 1);
+            if (begin < end)
+            {
+                body(begin, end);
+            }
+        });
+    }
+
+private:
+    void work(unsigned worker)
+    {
+        std::uint64_t seen = 0;
+        for (;;)
+        {
+            const std::function<void(unsigned)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                {
+                    return;
+                }
+                seen = generation_;
+                task = task_;
+            }
+
+            (*task)(worker);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+            {
+                done_.notify_one();
+            }
+        }
+    }
+
+    const unsigned size_;
+    std::vector<std::thread> threads_;
+    std::mutex run_mutex_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const std::function<void(unsigned)>* task_ = nullptr;
+    std::uint64_t generation_ = 0;
+    unsigned pending_ = 0;
+    bool stop_ = false;
+};
+
+/**
+ * Runs body(begin, end) over [0, count) elements of data on all workers of the pool, with
+ * every boundary between workers on a cache-line boundary of the array, so that no cache line
+ * is written by two threads.
+ *
+ * @param pool The pool to run on.
+ * @param data The array the ranges index into; only its address is used.
+ * @param count The number of elements.
+ * @param body Called with the half-open index range [begin, end) of one worker.
+ */
+template <typename T, typename Body>
+void parallel_for_cache_aligned(WorkerPool& pool, const T* data, std::size_t count, Body&& body)
+{
+    // Smallest number of elements that spans a whole number of cache lines
+    const std::size_t per_line = cache_line_bytes / std::gcd(sizeof(T), cache_line_bytes);
+
+    // First element that starts a cache line, if any does
+    std::size_t first = 0;
+    const auto address = reinterpret_cast<std::uintptr_t>(data);
+    while (first < per_line && (address + first * sizeof(T)) % cache_line_bytes != 0)
+    {
+        ++first;
+    }
+    if (first == per_line)
+    {
+        first = 0;
+    }
+
+    pool.parallel_for(count, per_line, std::forward<Body>(body), first);
+}
+
+#endif // WORKER_POOL_H